@@ -0,0 +1,120 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AdaptiveBinarizer.h"
+
+#include "BitMatrix.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ZXing {
+
+static constexpr int MIN_WINDOW_SIZE = 31;
+static constexpr float SAUVOLA_K = 0.2f;   // sensitivity to the local contrast
+static constexpr float SAUVOLA_R = 128.f; // dynamic range of the standard deviation
+
+AdaptiveBinarizer::AdaptiveBinarizer(const ImageView& iv, BitMatrixPool* pool, ThreadPool* threads, int window)
+	: GlobalHistogramBinarizer(iv, pool, threads),
+	  _radius((window > 0 ? window : std::max(MIN_WINDOW_SIZE, std::min(iv.width(), iv.height()) / 4)) / 2)
+{}
+
+AdaptiveBinarizer::~AdaptiveBinarizer() = default;
+
+// add (or subtract) the luminance values src[i * stride] to sum[i] and their squares to sqSum[i]
+template <bool ADD>
+static void AccumulateRow(const uint8_t* src, int stride, int n, uint32_t* sum, uint32_t* sqSum)
+{
+	auto run = [&](auto stride) {
+		for (int i = 0; i < n; ++i) {
+			uint32_t v = src[i * stride];
+			if constexpr (ADD)
+				sum[i] += v, sqSum[i] += v * v;
+			else
+				sum[i] -= v, sqSum[i] -= v * v;
+		}
+	};
+	// Specialize the inner loop for stride 1 to support auto vectorization
+	if (stride == 1)
+		run(std::integral_constant<int, 1>{});
+	else
+		run(stride);
+}
+
+// Binarize the pixels [left, right) x [top, bottom) of iv into matrix. The window statistics are computed by keeping
+// the column sums of the current window rows up to date (adding the row entering the window and subtracting the one
+// leaving it) and taking the prefix sums of those, i.e. a row of the integral image, for every output row.
+static void ThresholdRegion(const ImageView& iv, int radius, BitMatrix& matrix, int left, int top, int right, int bottom)
+{
+	const int width = iv.width(), height = iv.height(), stride = iv.pixStride();
+	const int x0 = std::max(0, left - radius), x1 = std::min(width, right + radius + 1), n = x1 - x0;
+
+	// The prefix sums are stored as double, which is exact for all realistic image sizes and (unlike uint64_t) can be
+	// converted to float with SIMD instructions.
+	std::vector<uint32_t> colSum(n), colSqSum(n);
+	std::vector<double> sum(n + 1), sqSum(n + 1);
+
+	for (int y = std::max(0, top - radius); y < std::min(height, top + radius + 1); ++y)
+		AccumulateRow<true>(iv.data(x0, y), stride, n, colSum.data(), colSqSum.data());
+
+	for (int y = top; y < bottom; ++y) {
+		if (y > top) {
+			if (y + radius < height)
+				AccumulateRow<true>(iv.data(x0, y + radius), stride, n, colSum.data(), colSqSum.data());
+			if (y - radius - 1 >= 0)
+				AccumulateRow<false>(iv.data(x0, y - radius - 1), stride, n, colSum.data(), colSqSum.data());
+		}
+
+		for (int i = 0; i < n; ++i) {
+			sum[i + 1] = sum[i] + colSum[i];
+			sqSum[i + 1] = sqSum[i] + colSqSum[i];
+		}
+
+		const int rows = std::min(height, y + radius + 1) - std::max(0, y - radius);
+		const uint8_t* src = iv.data(0, y);
+		auto* dst = matrix.row(y).begin();
+		auto threshold = [&](int x, int a, int b, float inv, auto stride) {
+			float mean = float(sum[b] - sum[a]) * inv;
+			float variance = float(sqSum[b] - sqSum[a]) * inv - mean * mean;
+			// L <= mean * (1 + k * (stddev / R - 1)) <=> d := L - mean * (1 - k) <= mean * k / R * stddev, which can be
+			// evaluated without the sqrt (that would prevent the vectorization)
+			float d = src[x * stride] - mean * (1.f - SAUVOLA_K);
+			float f = mean * (SAUVOLA_K / SAUVOLA_R);
+			dst[x] = ((d <= 0.f) | (d * d <= f * f * variance)) * BitMatrix::SET_V;
+		};
+		auto clipped = [&](int x) {
+			int a = std::max(0, x - radius) - x0, b = std::min(width, x + radius + 1) - x0;
+			threshold(x, a, b, 1.f / ((b - a) * rows), stride);
+		};
+		// The window of the pixels in [innerLeft, innerRight) is not clipped at the image border. Splitting those off
+		// and specializing for stride 1 lets the compiler vectorize the main loop.
+		const int innerLeft = std::clamp(radius, left, right), innerRight = std::clamp(width - radius - 1, innerLeft, right);
+		const float inv = 1.f / ((2 * radius + 1) * rows);
+		for (int x = left; x < innerLeft; ++x)
+			clipped(x);
+		if (stride == 1)
+			for (int x = innerLeft; x < innerRight; ++x)
+				threshold(x, x - radius - x0, x + radius + 1 - x0, inv, std::integral_constant<int, 1>{});
+		else
+			for (int x = innerLeft; x < innerRight; ++x)
+				threshold(x, x - radius - x0, x + radius + 1 - x0, inv, stride);
+		for (int x = innerRight; x < right; ++x)
+			clipped(x);
+	}
+}
+
+std::shared_ptr<const BitMatrix> AdaptiveBinarizer::getBlackMatrix() const
+{
+	auto matrix = newBitMatrix(width(), height());
+	forEachBand(height(), std::max(64, 2 * _radius), [&](int begin, int end) {
+		ThresholdRegion(_buffer, _radius, *matrix, 0, begin, width(), end);
+	});
+	return matrix;
+}
+
+} // ZXing
@@ -0,0 +1,39 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "GlobalHistogramBinarizer.h"
+
+namespace ZXing {
+
+/**
+* This Binarizer implements the local thresholding algorithm of Sauvola et al.: a pixel is black if its luminance is
+* below T = m * (1 + k * (s / 128 - 1)), where m and s are the mean and standard deviation of the surrounding window.
+* The window statistics are computed with running sums (a row-wise integral image), so the cost per pixel is
+* constant, independent of the window size.
+*
+* Compared to the HybridBinarizer, the threshold follows smooth gradients and shadows more closely and low contrast
+* noise in flat areas is suppressed by the standard deviation term. Like the HybridBinarizer it uses the global
+* histogram approach for the 1D readers.
+*/
+class AdaptiveBinarizer : public GlobalHistogramBinarizer
+{
+	int _radius = 0;
+
+public:
+	/**
+	* @param window  side length of the square neighborhood used to compute the threshold of a pixel. It needs to be
+	* larger than the biggest black feature of the symbols (e.g. the center of a QRCode finder pattern). The default
+	* of 0 means 1/4th of the smaller image dimension (at least 31), which is enough for a QRCode filling the image.
+	*/
+	explicit AdaptiveBinarizer(const ImageView& iv, BitMatrixPool* pool = nullptr, ThreadPool* threads = nullptr,
+							   int window = 0);
+	~AdaptiveBinarizer() override;
+
+	std::shared_ptr<const BitMatrix> getBlackMatrix() const override;
+};
+
+} // ZXing
@@ -6,23 +6,89 @@
 #include "BinaryBitmap.h"
 
 #include "BitMatrix.h"
+#include "ThreadPool.h"
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
 
 namespace ZXing {
 
 struct BinaryBitmap::Cache
 {
+	std::mutex mutex; // guards the lazy initialization of the matrices in getBitMatrix()
 	std::shared_ptr<const BitMatrix> matrix, transposed;
+	std::vector<QuadrilateralF> masked; // see mask()
+};
+
+struct BitMatrixPool::Data
+{
+	std::mutex mutex; // guards free, the deleter of a matrix may run in any thread
+	std::vector<std::unique_ptr<BitMatrix>> free; // the matrices given back, in the order they were released
 };
 
-BitMatrix BinaryBitmap::binarize(const uint8_t threshold) const
+BitMatrixPool::BitMatrixPool() : d(std::make_shared<Data>()) {}
+BitMatrixPool::~BitMatrixPool() = default;
+
+std::shared_ptr<BitMatrix> BitMatrixPool::acquire(int width, int height)
+{
+	std::unique_ptr<BitMatrix> matrix;
+	{
+		std::lock_guard lock(d->mutex);
+		auto i = std::find_if(d->free.begin(), d->free.end(),
+							  [=](auto& m) { return m->width() == width && m->height() == height; });
+		if (i != d->free.end()) {
+			matrix = std::move(*i);
+			d->free.erase(i);
+		}
+	}
+	if (!matrix)
+		matrix = std::make_unique<BitMatrix>(width, height);
+
+	// Taking the mutex to give the matrix back makes all writes of the releasing thread visible to the thread acquiring
+	// it next. The pool data is kept alive by the deleter, so the matrix may outlive the pool.
+	return {matrix.release(), [d = d](BitMatrix* m) {
+				// only keep a limited number of matrices around (e.g. in case the image size changes)
+				constexpr int MAX_POOL_SIZE = 16;
+				std::unique_ptr<BitMatrix> oldest;
+				std::lock_guard lock(d->mutex);
+				if (Size(d->free) >= MAX_POOL_SIZE) {
+					oldest = std::move(d->free.front());
+					d->free.erase(d->free.begin());
+				}
+				d->free.emplace_back(m);
+			}};
+}
+
+std::shared_ptr<BitMatrix> BinaryBitmap::newBitMatrix(int width, int height) const
+{
+	return _pool ? _pool->acquire(width, height) : std::make_shared<BitMatrix>(width, height);
+}
+
+void BinaryBitmap::forEachBand(int count, int minBandSize, const std::function<void(int begin, int end)>& func) const
+{
+	// a few more bands than threads help to balance the load
+	int bands = _threads ? std::clamp(count / std::max(1, minBandSize), 1, 4 * _threads->size()) : 1;
+	if (bands == 1)
+		return func(0, count);
+
+	_threads->parallelFor(bands, [&](int i, int) { func(count * i / bands, count * (i + 1) / bands); });
+}
+
+std::shared_ptr<BitMatrix> BinaryBitmap::binarize(const uint8_t threshold) const
 {
-	BitMatrix res(width(), height());
+	auto matrix = newBitMatrix(width(), height());
+	auto& res = *matrix;
 
 	if (_buffer.pixStride() == 1 && _buffer.rowStride() == _buffer.width()) {
 		// Specialize for a packed buffer with pixStride 1 to support auto vectorization (16x speedup on AVX2)
-		auto dst = res.row(0).begin();
-		for (auto src = _buffer.data(0, 0), end = _buffer.data(0, height()); src != end; ++src, ++dst)
-			*dst = (*src <= threshold) * BitMatrix::SET_V;
+		forEachBand(height(), 64, [&](int begin, int end) {
+			auto dst = res.row(begin).begin();
+			for (auto src = _buffer.data(0, begin), srcEnd = _buffer.data(0, end); src != srcEnd; ++src, ++dst)
+				*dst = (*src <= threshold) * BitMatrix::SET_V;
+		});
 	} else {
 		auto processLine = [&res, threshold](int y, const auto* src, const int stride) {
 			for (auto& dst : res.row(y)) {
@@ -30,44 +96,72 @@ BitMatrix BinaryBitmap::binarize(const uint8_t threshold) const
 				src += stride;
 			}
 		};
-		for (int y = 0; y < res.height(); ++y) {
-			auto src = _buffer.data(0, y) + GreenIndex(_buffer.format());
-			// Specialize the inner loop for strides 1 and 4 to support auto vectorization
-			switch (_buffer.pixStride()) {
-			case 1: processLine(y, src, 1); break;
-			case 4: processLine(y, src, 4); break;
-			default: processLine(y, src, _buffer.pixStride()); break;
+		forEachBand(height(), 64, [&](int begin, int end) {
+			for (int y = begin; y < end; ++y) {
+				auto src = _buffer.data(0, y) + GreenIndex(_buffer.format());
+				// Specialize the inner loop for strides 1 and 4 to support auto vectorization
+				switch (_buffer.pixStride()) {
+				case 1: processLine(y, src, 1); break;
+				case 4: processLine(y, src, 4); break;
+				default: processLine(y, src, _buffer.pixStride()); break;
+				}
 			}
-		}
+		});
 	}
 
-	return res;
+	return matrix;
 }
 
-BinaryBitmap::BinaryBitmap(const ImageView& buffer) : _cache(new Cache), _buffer(buffer) {}
+BinaryBitmap::BinaryBitmap(const ImageView& buffer, BitMatrixPool* pool, ThreadPool* threads)
+	: _cache(new Cache), _pool(pool), _threads(threads), _buffer(buffer)
+{}
 
 BinaryBitmap::~BinaryBitmap() = default;
 
 const BitMatrix* BinaryBitmap::getBitMatrix(bool transposed) const
 {
+	std::lock_guard lock(_cache->mutex);
 	if (!_cache->matrix) {
 		_cache->matrix = getBlackMatrix();
 	}
 	if (transposed) {
 		if (!_cache->transposed) {
-			auto copy = std::make_shared<BitMatrix>(_cache->matrix->copy());
-			copy->rotate90();
-			_cache->transposed = std::move(copy);
+			const auto& src = *_cache->matrix;
+			auto rotated = newBitMatrix(src.height(), src.width());
+			// same as BitMatrix::rotate90() but writing into the (recycled) result matrix
+			forEachBand(rotated->height(), 64, [&](int begin, int end) { Rotate90(src, *rotated, begin, end); });
+			_cache->transposed = std::move(rotated);
 		}
 		return _cache->transposed.get();
 	}
 	return _cache->matrix.get();
 }
 
+// Clear (set to white) all pixels inside the given regions
+static void ClearRegions(BitMatrix& matrix, const std::vector<QuadrilateralF>& regions)
+{
+	auto clamp = [](double v, int max) { return std::clamp(static_cast<int>(v), 0, max - 1); };
+
+	for (auto& q : regions) {
+		auto bb = BoundingBox(q);
+		for (int y = clamp(bb.topLeft().y, matrix.height()); y <= clamp(bb.bottomLeft().y + 1, matrix.height()); ++y)
+			for (int x = clamp(bb.topLeft().x, matrix.width()); x <= clamp(bb.topRight().x + 1, matrix.width()); ++x)
+				if (IsInside(PointF(x, y), q))
+					matrix.set(x, y, false);
+	}
+}
+
 void BinaryBitmap::invert()
 {
-	if (_cache->matrix)
-		const_cast<BitMatrix*>(_cache->matrix.get())->flipAll();
+	if (_cache->matrix) {
+		auto& matrix = *const_cast<BitMatrix*>(_cache->matrix.get());
+		matrix.flipAll();
+		// the masked regions stay white in either polarity, the transposed matrix is recomputed if needed
+		if (!_cache->masked.empty()) {
+			ClearRegions(matrix, _cache->masked);
+			_cache->transposed.reset();
+		}
+	}
 
 	if (_cache->transposed)
 		const_cast<BitMatrix*>(_cache->transposed.get())->flipAll();
@@ -75,37 +169,122 @@ void BinaryBitmap::invert()
 	_inverted = !_inverted;
 }
 
+// Set the pixels of out in the region [left, right) x [top, bottom) to func(sum of the 3x3 neighborhood in in), the
+// region must not contain border pixels. Returns whether any pixel changed.
 template <typename F>
-void SumFilter(const BitMatrix& in, BitMatrix& out, F func)
+static bool SumFilter(const BitMatrix& in, BitMatrix& out, int left, int top, int right, int bottom, F func)
 {
-	assert(in.height() >= 3);
-
-	const auto* in0 = in.row(0).begin();
-	const auto* in1 = in.row(1).begin();
-	const auto* in2 = in.row(2).begin();
-
-	for (auto *out1 = out.row(1).begin() + 1, *end = out.row(out.height() - 1).begin() - 1; out1 != end; ++in0, ++in1, ++in2, ++out1) {
-		int sum = 0;
-		for (int j = 0; j < 3; ++j)
-			sum += in0[j] + in1[j] + in2[j];
+	bool changed = false;
+	for (int y = top; y < bottom; ++y) {
+		const auto* in0 = in.row(y - 1).begin() - 1;
+		const auto* in1 = in.row(y).begin() - 1;
+		const auto* in2 = in.row(y + 1).begin() - 1;
+		auto* out1 = out.row(y).begin();
+		for (int x = left; x < right; ++x) {
+			int sum = 0;
+			for (int j = 0; j < 3; ++j)
+				sum += in0[x + j] + in1[x + j] + in2[x + j];
 
-		*out1 = func(sum);
+			uint8_t v = func(sum);
+			changed |= out1[x] != v;
+			out1[x] = v;
+		}
 	}
+	return changed;
 }
 
-void BinaryBitmap::close()
+bool BinaryBitmap::close()
 {
-	if (_cache->matrix) {
-		auto& matrix = *const_cast<BitMatrix*>(_cache->matrix.get());
-		BitMatrix tmp(matrix.width(), matrix.height());
+	_closed = true;
+	if (!_cache->matrix || width() < 3 || height() < 3)
+		return false;
 
-		// dilate
-		SumFilter(matrix, tmp, [](int sum) { return (sum > 0 * BitMatrix::SET_V) * BitMatrix::SET_V; });
-		// erode
-		SumFilter(tmp, matrix, [](int sum) { return (sum == 9 * BitMatrix::SET_V) * BitMatrix::SET_V; });
-	}
+	auto& matrix = *const_cast<BitMatrix*>(_cache->matrix.get());
+	const int W = width(), H = height();
+
+	// The closing can only change a pixel if its 5x5 neighborhood is not uniform or if it is black and close to the
+	// border (see below). So only the tiles containing an edge and their neighbors need to be processed. This only skips
+	// the uniform areas (e.g. the background around the symbols), in a textured image almost every tile is active. A
+	// tile contains an edge if it is not uniform, including the first column/row of its right/bottom neighbors.
+	constexpr int TILE = 32;
+	const int tilesX = (W + TILE - 1) / TILE, tilesY = (H + TILE - 1) / TILE;
+	std::vector<uint8_t> hasEdge(tilesX * tilesY), active(tilesX * tilesY);
+
+	forEachBand(tilesY, 1, [&](int begin, int end) {
+		for (int ty = begin; ty < end; ++ty)
+			for (int tx = 0; tx < tilesX; ++tx) {
+				int left = tx * TILE, top = ty * TILE, right = std::min(left + TILE + 1, W), bottom = std::min(top + TILE + 1, H);
+				auto v = matrix.row(top).begin()[left];
+				bool edge = false;
+				for (int y = top; y < bottom && !edge; ++y)
+					edge = std::any_of(matrix.row(y).begin() + left, matrix.row(y).begin() + right, [v](uint8_t p) { return p != v; });
+				// the pixels next to the border are always eroded, since the dilation does not touch the border
+				bool border = tx == 0 || ty == 0 || right >= W - 1 || bottom >= H - 1;
+				hasEdge[ty * tilesX + tx] = edge || (border && v == BitMatrix::SET_V);
+			}
+	});
+
+	for (int ty = 0; ty < tilesY; ++ty)
+		for (int tx = 0; tx < tilesX; ++tx)
+			for (int dy = -1; dy <= 1; ++dy)
+				for (int dx = -1; dx <= 1; ++dx) {
+					int x = tx + dx, y = ty + dy;
+					if (x >= 0 && x < tilesX && y >= 0 && y < tilesY && hasEdge[y * tilesX + x])
+						active[ty * tilesX + tx] = 1;
+				}
+
+	// the region of a tile without the border pixels, optionally grown by one pixel to the left and right. Growing it
+	// vertically as well would let two bands write the same rows concurrently.
+	auto forEachActiveTile = [&](int grow, auto func) {
+		std::atomic<bool> changed = false;
+		forEachBand(tilesY, 1, [&](int begin, int end) {
+			bool res = false;
+			for (int ty = begin; ty < end; ++ty)
+				for (int tx = 0; tx < tilesX; ++tx)
+					if (active[ty * tilesX + tx])
+						res |= func(std::max(1, tx * TILE - grow), std::max(1, ty * TILE), std::min(W - 1, (tx + 1) * TILE + grow),
+									std::min(H - 1, (ty + 1) * TILE));
+			if (res)
+				changed = true;
+		});
+		return changed.load();
+	};
+
+	auto tmpPtr = newBitMatrix(W, H);
+	auto& tmp = *tmpPtr;
+	// the dilation does not touch the border pixels
+	std::fill(tmp.row(0).begin(), tmp.row(H - 1).end(), BitMatrix::UNSET_V);
+
+	// dilate, the erosion of a tile needs the dilated pixels around it
+	auto dilate = [&](int left, int top, int right, int bottom) {
+		return SumFilter(matrix, tmp, left, top, right, bottom, [](int sum) { return (sum > 0) * BitMatrix::SET_V; });
+	};
+	forEachActiveTile(1, dilate);
+	// the rows above and below the tiles are shared with the neighboring bands, so they are dilated one after the other
+	for (int ty = 0; ty < tilesY; ++ty)
+		for (int tx = 0; tx < tilesX; ++tx)
+			if (active[ty * tilesX + tx]) {
+				int left = std::max(1, tx * TILE - 1), right = std::min(W - 1, (tx + 1) * TILE + 1);
+				if (int y = ty * TILE - 1; y >= 1)
+					dilate(left, y, right, y + 1);
+				if (int y = (ty + 1) * TILE; y < H - 1)
+					dilate(left, y, right, y + 1);
+			}
+	// erode
+	bool changed = forEachActiveTile(0, [&](int left, int top, int right, int bottom) {
+		return SumFilter(tmp, matrix, left, top, right, bottom, [](int sum) { return (sum == 9 * BitMatrix::SET_V) * BitMatrix::SET_V; });
+	});
+
+	if (changed)
+		_cache->transposed.reset();
+	return changed;
+}
+
+void BinaryBitmap::mask(const std::vector<QuadrilateralF>& regions)
+{
+	ClearRegions(*const_cast<BitMatrix*>(getBitMatrix()), regions);
+	_cache->masked.insert(_cache->masked.end(), regions.begin(), regions.end());
 	_cache->transposed.reset();
-	_closed = true;
 }
 
 } // ZXing
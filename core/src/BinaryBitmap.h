@@ -8,31 +8,68 @@
 #pragma once
 
 #include "ImageView.h"
+#include "Quadrilateral.h"
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <vector>
 
 namespace ZXing {
 
 class BitMatrix;
+class ThreadPool;
 
 using PatternRow = std::vector<uint16_t>;
 
+/**
+* Keeps the memory of BitMatrix objects alive to be handed out again to the next BinaryBitmap requesting a matrix of
+* the same size. This saves the (re-)allocations when processing a sequence of images, see ReaderSession. A matrix is
+* given back to the pool by the deleter of the shared_ptr returned from acquire(), i.e. once no BinaryBitmap refers to it
+* anymore, hence its content is undefined when returned from acquire(). The pool may be shared between BinaryBitmap
+* objects living in different threads and the matrices may outlive it.
+*/
+class BitMatrixPool
+{
+	struct Data;
+	std::shared_ptr<Data> d; // shared with the deleters of the matrices handed out
+
+public:
+	BitMatrixPool();
+	~BitMatrixPool();
+
+	std::shared_ptr<BitMatrix> acquire(int width, int height);
+};
+
 /**
 * This class is the core bitmap class used by ZXing to represent 1 bit data. Reader objects
 * accept a BinaryBitmap and attempt to decode it.
+*
+* The const interface is thread-safe, i.e. multiple readers may process the same BinaryBitmap concurrently.
 */
 class BinaryBitmap
 {
 	struct Cache;
 	std::unique_ptr<Cache> _cache;
+	BitMatrixPool* _pool = nullptr;
+	ThreadPool* _threads = nullptr;
 	bool _inverted = false;
 	bool _closed = false;
 
 protected:
 	const ImageView _buffer;
 
+	/**
+	* Returns a new (uninitialized) matrix, recycled from the BitMatrixPool if one was passed to the constructor.
+	*/
+	std::shared_ptr<BitMatrix> newBitMatrix(int width, int height) const;
+
+	/**
+	* Calls func(begin, end) for consecutive bands [begin, end) covering [0, count), e.g. the rows of the image. If a
+	* ThreadPool was passed to the constructor, the bands (of at least minBandSize) are processed concurrently.
+	*/
+	void forEachBand(int count, int minBandSize, const std::function<void(int begin, int end)>& func) const;
+
 	/**
 	* Converts a 2D array of luminance data to 1 bit (true means black).
 	*
@@ -40,15 +77,24 @@ protected:
 	*/
 	virtual std::shared_ptr<const BitMatrix> getBlackMatrix() const = 0;
 
-	BitMatrix binarize(uint8_t threshold) const;
+	std::shared_ptr<BitMatrix> binarize(uint8_t threshold) const;
 
 public:
-	BinaryBitmap(const ImageView& buffer);
+	/**
+	* @param buffer  the image to binarize, it needs to outlive this object
+	* @param pool  optional BitMatrixPool to recycle the matrices from
+	* @param threads  optional ThreadPool to binarize large images in horizontal bands concurrently, the result is
+	* identical to the serial computation
+	*/
+	BinaryBitmap(const ImageView& buffer, BitMatrixPool* pool = nullptr, ThreadPool* threads = nullptr);
 	virtual ~BinaryBitmap();
 
 	int width() const { return _buffer.width(); }
 	int height() const { return _buffer.height(); }
 
+	/// The ThreadPool passed to the constructor (if any), e.g. for a reader to process independent rows concurrently.
+	ThreadPool* threads() const { return _threads; }
+
 	/**
 	* Converts one row of luminance data to a vector of ints denoting the widths of the bars and spaces.
 	*/
@@ -59,8 +105,21 @@ public:
 	void invert();
 	bool inverted() const { return _inverted; }
 
-	void close();
+	/**
+	* Applies a morphological closing (3x3 dilation followed by erosion) to the matrix, which fills small gaps in the
+	* black areas, e.g. of noisy symbols. The border pixels are not touched. Only the areas containing edges are
+	* processed, the result is the same as for the whole matrix.
+	*
+	* @return false if nothing changed (or there is no matrix yet), i.e. reading the closed image gives no new results
+	*/
+	bool close();
 	bool closed() const { return _closed; }
+
+	/**
+	* Clears (sets to white) all pixels inside the given regions, e.g. to hide already decoded symbols from the
+	* detectors. Binarizes the image if that did not already happen. The regions stay white when the bitmap is inverted.
+	*/
+	void mask(const std::vector<QuadrilateralF>& regions);
 };
 
 } // ZXing
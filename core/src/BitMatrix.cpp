@@ -9,6 +9,8 @@
 #include "Pattern.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <stdexcept>
 #include <utility>
 
@@ -40,13 +42,7 @@ void
 BitMatrix::rotate90()
 {
 	BitMatrix result(height(), width());
-	for (int x = 0; x < width(); ++x) {
-		for (int y = 0; y < height(); ++y) {
-			if (get(x, y)) {
-				result.set(y, width() - x - 1);
-			}
-		}
-	}
+	Rotate90(*this, result, 0, result.height());
 	*this = std::move(result);
 }
 
@@ -121,6 +117,68 @@ BitMatrix::getBottomRightOnBit(int& right, int& bottom) const
 	return true;
 }
 
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Transposes a block of 8x8 bytes held in 8 words (one row each) in 3 rounds of swapping 1, 2 and 4 byte wide sub-blocks.
+static void Transpose8x8(uint64_t (&r)[8])
+{
+	for (int i = 0; i < 8; i += 2) {
+		uint64_t t = ((r[i] >> 8) ^ r[i + 1]) & 0x00FF00FF00FF00FFull;
+		r[i + 1] ^= t;
+		r[i] ^= t << 8;
+	}
+	for (int i : {0, 1, 4, 5}) {
+		uint64_t t = ((r[i] >> 16) ^ r[i + 2]) & 0x0000FFFF0000FFFFull;
+		r[i + 2] ^= t;
+		r[i] ^= t << 16;
+	}
+	for (int i = 0; i < 4; ++i) {
+		uint64_t t = ((r[i] >> 32) ^ r[i + 4]) & 0x00000000FFFFFFFFull;
+		r[i + 4] ^= t;
+		r[i] ^= t << 32;
+	}
+}
+#endif
+
+void Rotate90(const BitMatrix& src, BitMatrix& dst, int rowBegin, int rowEnd)
+{
+	// row y of dst is column (W - 1 - y) of src, read from top to bottom. Reading a whole column at once would
+	// touch a new cache line for every pixel, so the work is done in blocks of 64x64 pixels (2x4 KB) that stay in
+	// the L1 cache. Inside a block, 8x8 pixels are transposed at a time in 8 64-bit words with plain integer
+	// operations, no SIMD instructions are needed.
+	constexpr int BLOCK = 64;
+	const int W = src.width(), H = src.height();
+	const auto* s = src.row(0).begin();
+	auto* d = dst.row(0).begin();
+
+	auto rotatePixels = [&](int x0, int x1, int y0, int y1) {
+		for (int y = y0; y < y1; ++y)
+			for (int x = x0; x < x1; ++x)
+				d[y * H + x] = s[x * W + W - 1 - y];
+	};
+
+	for (int by = rowBegin; by < rowEnd; by += BLOCK)
+		for (int bx = 0; bx < H; bx += BLOCK) {
+			int ey = std::min(by + BLOCK, rowEnd), ex = std::min(bx + BLOCK, H);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			// the 8x8 sub-blocks, the remaining pixels at the right and bottom border are rotated one by one
+			int fy = by + (ey - by) / 8 * 8, fx = bx + (ex - bx) / 8 * 8;
+			for (int y = by; y < fy; y += 8)
+				for (int x = bx; x < fx; x += 8) {
+					uint64_t r[8];
+					for (int i = 0; i < 8; ++i)
+						r[i] = LoadU<uint64_t>(s + (x + i) * W + W - y - 8);
+					Transpose8x8(r);
+					for (int i = 0; i < 8; ++i)
+						std::memcpy(d + (y + 7 - i) * H + x, &r[i], 8);
+				}
+			rotatePixels(fx, ex, by, fy);
+			rotatePixels(bx, ex, fy, ey);
+#else
+			rotatePixels(bx, ex, by, ey);
+#endif
+		}
+}
+
 void GetPatternRow(const BitMatrix& matrix, int r, std::vector<uint16_t>& pr, bool transpose)
 {
 	if (transpose)
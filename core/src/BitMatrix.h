@@ -153,6 +153,12 @@ public:
 
 void GetPatternRow(const BitMatrix& matrix, int r, std::vector<uint16_t>& pr, bool transpose);
 
+/**
+ * @brief Rotate90 computes the rows [rowBegin, rowEnd) of the counterclockwise rotation of src (see BitMatrix::rotate90())
+ * @param dst destination matrix of size src.height() x src.width(), the other rows are not touched
+ */
+void Rotate90(const BitMatrix& src, BitMatrix& dst, int rowBegin, int rowEnd);
+
 /**
  * @brief Inflate scales a BitMatrix up and adds a quiet Zone plus padding
  * @param input matrix to be expanded
@@ -24,7 +24,8 @@ inline Direction opposite(Direction dir) noexcept
  * @brief The BitMatrixCursor represents a current position inside an image and current direction it can advance towards.
  *
  * The current position and direction is a PointT<T>. So depending on the type it can be used to traverse the image
- * in a Bresenham style (PointF) or in a discrete way (step only horizontal/vertical/diagonal (PointI)).
+ * in a Bresenham style (PointF) or in a discrete way (step only horizontal/vertical/diagonal (PointI)). An inverted
+ * cursor reads the image with swapped polarity, i.e. a set bit is considered white, without touching the image itself.
  */
 template<typename POINT>
 class BitMatrixCursor
@@ -36,8 +37,12 @@ public:
 
 	POINT p; // current position
 	POINT d; // current direction
+	bool inverted = false; // polarity, see above
 
-	BitMatrixCursor(const BitMatrix& image, POINT p, POINT d) : img(&image), p(p) { setDirection(d); }
+	BitMatrixCursor(const BitMatrix& image, POINT p, POINT d, bool inverted = false) : img(&image), p(p), inverted(inverted)
+	{
+		setDirection(d);
+	}
 
 	class Value
 	{
@@ -58,7 +63,7 @@ public:
 	template <typename T>
 	Value testAt(PointT<T> p) const
 	{
-		return img->isIn(p) ? Value{img->get(p)} : Value{};
+		return img->isIn(p) ? Value{img->get(p) != inverted} : Value{};
 	}
 
 	bool blackAt(POINT pos) const noexcept { return testAt(pos).isBlack(); }
@@ -101,8 +106,8 @@ public:
 		return isIn(p);
 	}
 
-	this_t movedBy(POINT o) const noexcept { return {*img, p + o, d}; }
-	this_t turnedBack() const noexcept { return {*img, p, back()}; }
+	this_t movedBy(POINT o) const noexcept { return {*img, p + o, d, inverted}; }
+	this_t turnedBack() const noexcept { return {*img, p, back(), inverted}; }
 
 	/**
 	 * @brief stepToEdge advances cursor to one step behind the next (or n-th) edge.
@@ -289,12 +289,15 @@ std::optional<QuadrilateralF> FindConcentricPatternCorners(const BitMatrix& imag
 	return res;
 }
 
-std::optional<ConcentricPattern> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int width, int finderPatternSize)
+std::optional<ConcentricPattern> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int width, int finderPatternSize,
+																 bool inverted)
 {
+	auto isBlack = [&](PointF p) { return image.get(p) != inverted; };
+
 	// make sure we have at least one path of white around the center
-	if (auto res1 = CenterOfRing(image, PointI(center), width * 2 / 3, 1); res1 && image.get(*res1)) {
+	if (auto res1 = CenterOfRing(image, PointI(center), width * 2 / 3, 1); res1 && isBlack(*res1)) {
 		// and then either at least one more ring around that
-		if (auto res2 = CenterOfRings(image, *res1, width, finderPatternSize / 2); res2 && image.get(*res2)) {
+		if (auto res2 = CenterOfRings(image, *res1, width, finderPatternSize / 2); res2 && isBlack(*res2)) {
 			res2->size = res2->size * 7 / 5; // CenterOfRings only estimates the radius of the white ring
 			return res2;
 		}
@@ -303,7 +306,7 @@ std::optional<ConcentricPattern> FinetuneConcentricPatternCenter(const BitMatrix
 		// if (FitSquareToPoints(image, *res1, width, 1, false))
 		// 	return res1;
 		// TODO: this is currently only keeping #258 alive, evaluate if still worth it
-		if (auto res2 = CenterOfDoubleCross(image, PointI(*res1), width, finderPatternSize / 2 + 1); res2 && image.get(*res2))
+		if (auto res2 = CenterOfDoubleCross(image, PointI(*res1), width, finderPatternSize / 2 + 1); res2 && isBlack(*res2))
 			return res2;
 	}
 	return {};
@@ -105,16 +105,19 @@ struct ConcentricPattern : public PointF
 
 std::optional<ConcentricPattern> CenterOfRing(const BitMatrix& image, PointI center, int range, int nth, bool requireCircle = true);
 
-std::optional<ConcentricPattern> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize);
-
 std::optional<QuadrilateralF> FitSquareToPoints(const BitMatrix& image, PointF center, int range, int lineIndex, bool backup);
 
 std::optional<QuadrilateralF> FindConcentricPatternCorners(const BitMatrix& image, PointF center, int range, int ringIndex);
 
+// The ring tracing functions above work for either polarity, the following ones need to know it, see BitMatrixCursor::inverted.
+std::optional<ConcentricPattern> FinetuneConcentricPatternCenter(const BitMatrix& image, PointF center, int range, int finderPatternSize,
+																 bool inverted = false);
+
 template <bool E2E = false, typename PATTERN>
-std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image, PATTERN pattern, PointF center, int width)
+std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image, PATTERN pattern, PointF center, int width,
+														 bool inverted = false)
 {
-	auto cur = BitMatrixCursor(image, PointI(center), {});
+	auto cur = BitMatrixCursor(image, PointI(center), {}, inverted);
 	int range = width * 2;
 	int minSpread = image.width(), maxSpread = 0;
 	// TODO: setting maxError to 1 can substantially help with detecting symbols with low print quality resulting in damaged
@@ -142,7 +145,7 @@ std::optional<ConcentricPattern> LocateConcentricPattern(const BitMatrix& image,
 		return {};
 
 	static_assert(pattern.sum() == 7, "see FinetuneConcentricPatternCenter()");
-	auto newCenter = FinetuneConcentricPatternCenter(image, PointF(cur.p), width, pattern.size());
+	auto newCenter = FinetuneConcentricPatternCenter(image, PointF(cur.p), width, pattern.size(), inverted);
 	if (newCenter) {
 		// log_l("LocateConcentricPattern: center=(%5.2f,%5.2f), width=%3d, spread=%d, size=%d, newCenter=(%5.2f,%5.2f)",
 		// 	center.x*5, center.y*5, width, (maxSpread + minSpread) / 2, newCenter->size, newCenter->x*5, newCenter->y*5);
@@ -0,0 +1,47 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Deadline.h"
+
+namespace ZXing {
+
+// innermost Scope of the current thread, always thread_local (unlike ZX_THREAD_LOCAL scratch buffers): with a shared
+// one, the Scopes of different threads would replace each other
+static thread_local const Deadline::Scope* currentScope = nullptr;
+
+Deadline::Scope::Scope(const Deadline& deadline) : _deadline(deadline), _outer(currentScope)
+{
+	currentScope = this;
+}
+
+Deadline::Scope::~Scope()
+{
+	currentScope = _outer;
+}
+
+Deadline::Inherit::Inherit(const Scope* scope) : _prev(currentScope)
+{
+	currentScope = scope;
+}
+
+Deadline::Inherit::~Inherit()
+{
+	currentScope = _prev;
+}
+
+const Deadline::Scope* Deadline::CurrentScope()
+{
+	return currentScope;
+}
+
+bool Deadline::Expired()
+{
+	for (auto scope = currentScope; scope; scope = scope->_outer)
+		if (scope->_deadline.expired())
+			return true;
+	return false;
+}
+
+} // ZXing
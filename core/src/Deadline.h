@@ -0,0 +1,99 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace ZXing {
+
+/**
+ * @brief Point in time and/or cancellation flag after which a read operation should stop as soon as possible.
+ *
+ * The deadlines of the currently running operations are installed for the current thread with Deadline::Scope
+ * objects. Long running loops (pyramid layers, format readers, scan lines, detector candidates) poll
+ * Deadline::Expired() and stop early, so whatever has been found so far is returned.
+ */
+class Deadline
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	/// A Deadline that never expires.
+	Deadline() = default;
+
+	/// @param timeout  0 means no time limit
+	/// @param cancelled  optional flag that can be set from another thread to cancel the operation
+	explicit Deadline(std::chrono::microseconds timeout, const std::atomic<bool>* cancelled = nullptr)
+		: _time(timeout.count() > 0 ? Clock::now() + timeout : Clock::time_point::max()), _cancelled(cancelled)
+	{}
+
+	Deadline(const Deadline&) = delete;
+	Deadline& operator=(const Deadline&) = delete;
+
+	/// Returns true if the point in time has been reached or the operation was cancelled.
+	bool expired() const
+	{
+		if (_reached.load(std::memory_order_relaxed))
+			return true;
+		if ((_cancelled && _cancelled->load(std::memory_order_relaxed)) || (_time != Clock::time_point::max() && Clock::now() >= _time)) {
+			_reached = true;
+			return true;
+		}
+		return false;
+	}
+
+	/// Returns true if expired() ever returned true, i.e. if some work might have been skipped.
+	bool reached() const { return _reached; }
+
+	/// Checks all deadlines installed for the current thread (false if there are none).
+	static bool Expired();
+
+	/**
+	 * Installs a deadline for the current thread during the lifetime of the Scope object. Nested scopes are checked
+	 * as well, i.e. an inner operation stops if any of the outer ones expired.
+	 */
+	class Scope
+	{
+		const Deadline& _deadline;
+		const Scope* _outer;
+
+		friend class Deadline;
+
+	public:
+		explicit Scope(const Deadline& deadline);
+		~Scope();
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	/// The innermost Scope installed for the current thread (nullptr if there is none), see Inherit.
+	static const Scope* CurrentScope();
+
+	/**
+	 * Installs the deadlines of another thread (see CurrentScope()) for the current thread during the lifetime of the
+	 * Inherit object, e.g. in the worker threads of a ThreadPool. The other thread has to keep its scopes alive.
+	 */
+	class Inherit
+	{
+		const Scope* _prev;
+
+	public:
+		explicit Inherit(const Scope* scope);
+		~Inherit();
+
+		Inherit(const Inherit&) = delete;
+		Inherit& operator=(const Inherit&) = delete;
+	};
+
+private:
+	Clock::time_point _time = Clock::time_point::max();
+	const std::atomic<bool>* _cancelled = nullptr;
+	mutable std::atomic<bool> _reached = false;
+};
+
+} // ZXing
@@ -22,7 +22,9 @@ static constexpr int LUMINANCE_BUCKETS = 1 << LUMINANCE_BITS;
 
 using Histogram = std::array<uint16_t, LUMINANCE_BUCKETS>;
 
-GlobalHistogramBinarizer::GlobalHistogramBinarizer(const ImageView& buffer) : BinaryBitmap(buffer) {}
+GlobalHistogramBinarizer::GlobalHistogramBinarizer(const ImageView& buffer, BitMatrixPool* pool, ThreadPool* threads)
+	: BinaryBitmap(buffer, pool, threads), _lineBlackPoints(new std::atomic<int16_t>[buffer.height() + buffer.width()]{})
+{}
 
 GlobalHistogramBinarizer::~GlobalHistogramBinarizer() = default;
 
@@ -152,8 +154,19 @@ bool GlobalHistogramBinarizer::getPatternRow(int row, int rotation, PatternRow&
 
 	auto packedLineView =
 		lineView.begin().stride == 1 ? Range(lineView.begin().pos, lineView.end().pos) : Range<const uint8_t*>(nullptr, nullptr);
-	auto histogram = packedLineView ? GenHistogram(packedLineView) : GenHistogram(lineView);
-	auto threshold = EstimateBlackPoint(histogram) - 1;
+
+	// the histogram of a line is the same in both directions, see the rotated() implementation for the line index
+	rotation = (rotation + 360) % 360;
+	int line = rotation % 180 ? height() + (rotation == 90 ? row : width() - 1 - row) : (rotation ? height() - 1 - row : row);
+	auto& cachedBlackPoint = _lineBlackPoints[line];
+
+	int threshold = cachedBlackPoint.load(std::memory_order_relaxed);
+	if (!threshold) {
+		auto histogram = packedLineView ? GenHistogram(packedLineView) : GenHistogram(lineView);
+		threshold = std::max(-1, EstimateBlackPoint(histogram) - 1);
+		// concurrent calls for the same line may both get here, they store the same value
+		cachedBlackPoint.store(threshold ? threshold : -1, std::memory_order_relaxed);
+	}
 	if (threshold <= 0)
 		return false;
 
@@ -181,7 +194,7 @@ GlobalHistogramBinarizer::getBlackMatrix() const
 			const uint8_t* luminances = _buffer.data(0, row);
 			int right = (width() * 4) / 5;
 			for (int x = width() / 5; x < right; x++)
-				localBuckets[luminances[x] >> LUMINANCE_SHIFT]++;
+				localBuckets[luminances[x * _buffer.pixStride()] >> LUMINANCE_SHIFT]++;
 		}
 	}
 
@@ -189,9 +202,7 @@ GlobalHistogramBinarizer::getBlackMatrix() const
 	if (blackPoint <= 0)
 		return {};
 
-
-
-	return std::make_shared<const BitMatrix>(binarize(blackPoint));
+	return binarize(blackPoint);
 }
 
 } // ZXing
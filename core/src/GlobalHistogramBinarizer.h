@@ -8,6 +8,10 @@
 
 #include "BinaryBitmap.h"
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
 namespace ZXing {
 
 /**
@@ -24,11 +28,16 @@ namespace ZXing {
 class GlobalHistogramBinarizer : public BinaryBitmap
 {
 public:
-	explicit GlobalHistogramBinarizer(const ImageView& buffer);
+	explicit GlobalHistogramBinarizer(const ImageView& buffer, BitMatrixPool* pool = nullptr, ThreadPool* threads = nullptr);
 	~GlobalHistogramBinarizer() override;
 
 	bool getPatternRow(int row, int rotation, PatternRow &res) const override;
 	std::shared_ptr<const BitMatrix> getBlackMatrix() const override;
+
+private:
+	// The black points of the rows (followed by the columns) already requested by getPatternRow(), 0 means unknown,
+	// -1 means not enough contrast. They don't depend on the rotation or on inverted(), so a line is only analyzed once.
+	std::unique_ptr<std::atomic<int16_t>[]> _lineBlackPoints;
 };
 
 } // ZXing
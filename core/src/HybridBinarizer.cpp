@@ -12,7 +12,9 @@
 #include <algorithm>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <vector>
 
 #define USE_NEW_ALGORITHM
 
@@ -24,10 +26,35 @@ static constexpr int BLOCK_SIZE = 8;
 static constexpr int WINDOW_SIZE = BLOCK_SIZE * (1 + 2 * 2);
 static constexpr int MIN_DYNAMIC_RANGE = 24;
 
-HybridBinarizer::HybridBinarizer(const ImageView& iv) : GlobalHistogramBinarizer(iv) {}
+using T_t = uint8_t;
+
+// Lower and upper bounds of the luminance of each block of an image, they are exact for the blocks with contrast.
+struct HybridBinarizer::BlockBounds
+{
+	int width = 0, height = 0; // of the image
+	Matrix<T_t> min, max;
+};
+
+HybridBinarizer::HybridBinarizer(const ImageView& iv, BitMatrixPool* pool, ThreadPool* threads, const HybridBinarizer* parent)
+	: GlobalHistogramBinarizer(iv, pool, threads)
+{
+	if (auto bounds = parent ? parent->blockBounds() : nullptr) {
+		int factor = bounds->width / std::max(1, width());
+		if (factor >= 2 && bounds->width / factor == width() && bounds->height / factor == height()) {
+			_parentBounds = std::move(bounds);
+			_parentFactor = factor;
+		}
+	}
+}
 
 HybridBinarizer::~HybridBinarizer() = default;
 
+std::shared_ptr<const HybridBinarizer::BlockBounds> HybridBinarizer::blockBounds() const
+{
+	std::lock_guard lock(_boundsMutex);
+	return _bounds;
+}
+
 bool HybridBinarizer::getPatternRow(int row, int rotation, PatternRow& res) const
 {
 #if 1
@@ -45,32 +72,33 @@ bool HybridBinarizer::getPatternRow(int row, int rotation, PatternRow& res) cons
 #endif
 }
 
-using T_t = uint8_t;
+#ifndef USE_NEW_ALGORITHM
 
 /**
 * Applies a single threshold to a block of pixels.
 */
 static void ThresholdBlock(const uint8_t* __restrict luminances, int xoffset, int yoffset, T_t threshold, int rowStride,
-						   BitMatrix& matrix)
+						   int pixStride, BitMatrix& matrix)
 {
 	for (int y = yoffset; y < yoffset + BLOCK_SIZE; ++y) {
-		auto* src = luminances + y * rowStride + xoffset;
+		auto* src = luminances + y * rowStride + xoffset * pixStride;
 		auto* const dstBegin = matrix.row(y).begin() + xoffset;
-		// TODO: fix pixelStride > 1 case
-		for (auto* dst = dstBegin; dst < dstBegin + BLOCK_SIZE; ++dst, ++src)
-			*dst = (*src <= threshold) * BitMatrix::SET_V;
+		if (pixStride == 1) // let the auto-vectorizer see the common dense case
+			for (auto* dst = dstBegin; dst < dstBegin + BLOCK_SIZE; ++dst, ++src)
+				*dst = (*src <= threshold) * BitMatrix::SET_V;
+		else
+			for (auto* dst = dstBegin; dst < dstBegin + BLOCK_SIZE; ++dst, src += pixStride)
+				*dst = (*src <= threshold) * BitMatrix::SET_V;
 	}
 }
 
-#ifndef USE_NEW_ALGORITHM
-
 /**
 * Calculates a single black point for each block of pixels and saves it away.
 * See the following thread for a discussion of this algorithm:
 *  http://groups.google.com/group/zxing/browse_thread/thread/d06efa2c35a7ddc0
 */
 static Matrix<T_t> CalculateBlackPoints(const uint8_t* __restrict luminances, int subWidth, int subHeight, int width, int height,
-										int rowStride)
+										int rowStride, int pixStride)
 {
 	Matrix<T_t> blackPoints(subWidth, subHeight);
 
@@ -79,11 +107,11 @@ static Matrix<T_t> CalculateBlackPoints(const uint8_t* __restrict luminances, in
 		for (int x = 0; x < subWidth; x++) {
 			int xoffset = std::min(x * BLOCK_SIZE, width - BLOCK_SIZE);
 			int sum = 0;
-			uint8_t min = luminances[yoffset * rowStride + xoffset];
+			uint8_t min = luminances[yoffset * rowStride + xoffset * pixStride];
 			uint8_t max = min;
-			for (int yy = 0, offset = yoffset * rowStride + xoffset; yy < BLOCK_SIZE; yy++, offset += rowStride) {
+			for (int yy = 0, offset = yoffset * rowStride + xoffset * pixStride; yy < BLOCK_SIZE; yy++, offset += rowStride) {
 				for (int xx = 0; xx < BLOCK_SIZE; xx++) {
-					auto pixel = luminances[offset + xx];
+					auto pixel = luminances[offset + xx * pixStride];
 					sum += pixel;
 					if (pixel < min)
 						min = pixel;
@@ -95,7 +123,7 @@ static Matrix<T_t> CalculateBlackPoints(const uint8_t* __restrict luminances, in
 					// finish the rest of the rows quickly
 					for (yy++, offset += rowStride; yy < BLOCK_SIZE; yy++, offset += rowStride) {
 						for (int xx = 0; xx < BLOCK_SIZE; xx++) {
-							sum += luminances[offset + xx];
+							sum += luminances[offset + xx * pixStride];
 						}
 					}
 				}
@@ -139,7 +167,7 @@ static Matrix<T_t> CalculateBlackPoints(const uint8_t* __restrict luminances, in
 * on the last pixels in the row/column which are also used in the previous block).
 */
 static std::shared_ptr<BitMatrix> CalculateMatrix(const uint8_t* __restrict luminances, int subWidth, int subHeight, int width,
-												  int height, int rowStride, const Matrix<T_t>& blackPoints)
+												  int height, int rowStride, int pixStride, const Matrix<T_t>& blackPoints)
 {
 	auto matrix = std::make_shared<BitMatrix>(width, height);
 
@@ -161,7 +189,7 @@ static std::shared_ptr<BitMatrix> CalculateMatrix(const uint8_t* __restrict lumi
 				}
 			}
 			int average = sum / 25;
-			ThresholdBlock(luminances, xoffset, yoffset, average, rowStride, *matrix);
+			ThresholdBlock(luminances, xoffset, yoffset, average, rowStride, pixStride, *matrix);
 
 #ifdef PRINT_DEBUG
 			for (int yy = 0; yy < 8; ++yy)
@@ -187,30 +215,92 @@ static std::shared_ptr<BitMatrix> CalculateMatrix(const uint8_t* __restrict lumi
 
 #else
 
+// Calls func(begin, end) for bands of rows covering [0, count), possibly concurrently, see BinaryBitmap::forEachBand()
+using ForEachBand = std::function<void(int count, int minBandSize, const std::function<void(int begin, int end)>& func)>;
+
+// The first pixel of block i in a row/column of the given size, the last block is aligned with the border, see ThresholdImage()
+static int BlockStart(int i, int size)
+{
+	return std::min(i * BLOCK_SIZE, size - BLOCK_SIZE);
+}
+
 // Subdivide the image in blocks of BLOCK_SIZE and calculate one threshold value per block as
 // (max - min > MIN_DYNAMIC_RANGE) ? (max + min) / 2 : 0
-static Matrix<T_t> BlockThresholds(const ImageView iv)
+// The min and max values are stored in bounds. If the bounds of the parent image iv has been downscaled from by the given
+// factor are known, the blocks that can not have enough contrast are skipped.
+static Matrix<T_t> BlockThresholds(const ImageView iv, const ForEachBand& forEachBand, HybridBinarizer::BlockBounds& bounds,
+								   const HybridBinarizer::BlockBounds* parent, int factor)
 {
 	int subWidth = (iv.width() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(width/BS)
 	int subHeight = (iv.height() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(height/BS)
 
 	Matrix<T_t> thresholds(subWidth, subHeight);
+	bounds = {iv.width(), iv.height(), Matrix<T_t>(subWidth, subHeight), Matrix<T_t>(subWidth, subHeight)};
+
+	auto hasContrast = [&](int x, int y) { return bounds.max(x, y) - bounds.min(x, y) > MIN_DYNAMIC_RANGE; };
+
+	// Instead of processing one 8x8 block after the other, first reduce the BLOCK_SIZE rows of a block row to a min and
+	// a max per column. Those loops run over the full image width and are simple enough for the auto-vectorizer.
+	forEachBand(subHeight, 64 / BLOCK_SIZE, [&](int begin, int end) {
+		std::vector<uint8_t> colMin(iv.width()), colMax(iv.width());
+
+		for (int y = begin; y < end; y++) {
+			int y0 = BlockStart(y, iv.height());
+			int first = 0, last = subWidth; // the blocks that need to be looked at
+			if (parent) {
+				// Every pixel is the average of factor x factor parent pixels, so a block can not have more contrast than
+				// the parent blocks covering the same area. The blocks at the beginning and end of the row without
+				// contrast are skipped, which is what we typically find around a symbol.
+				int py0 = y0 * factor / BLOCK_SIZE, py1 = ((y0 + BLOCK_SIZE) * factor - 1) / BLOCK_SIZE;
+				for (int x = 0; x < subWidth; x++) {
+					int x0 = BlockStart(x, iv.width());
+					uint8_t min = 255;
+					uint8_t max = 0;
+					for (int py = py0; py <= py1; py++)
+						for (int px = x0 * factor / BLOCK_SIZE; px <= ((x0 + BLOCK_SIZE) * factor - 1) / BLOCK_SIZE; px++) {
+							min = std::min(min, parent->min(px, py));
+							max = std::max(max, parent->max(px, py));
+						}
+					bounds.min(x, y) = min;
+					bounds.max(x, y) = max;
+				}
+				while (first < last && !hasContrast(first, y))
+					++first;
+				while (last > first && !hasContrast(last - 1, y))
+					--last;
+			}
 
-	for (int y = 0; y < subHeight; y++) {
-		int y0 = std::min(y * BLOCK_SIZE, iv.height() - BLOCK_SIZE);
-		for (int x = 0; x < subWidth; x++) {
-			int x0 = std::min(x * BLOCK_SIZE, iv.width() - BLOCK_SIZE);
-			uint8_t min = 255;
-			uint8_t max = 0;
+			// the pixels [left, right) belong to the blocks [first, last)
+			int left = first < last ? BlockStart(first, iv.width()) : 0;
+			int right = first < last ? BlockStart(last - 1, iv.width()) + BLOCK_SIZE : 0;
+			std::fill(colMin.begin() + left, colMin.begin() + right, 255);
+			std::fill(colMax.begin() + left, colMax.begin() + right, 0);
 			for (int yy = 0; yy < BLOCK_SIZE; yy++) {
-				auto line = iv.data(x0, y0 + yy);
-				for (int xx = 0; xx < BLOCK_SIZE; xx++)
-					UpdateMinMax(min, max, line[xx]);
+				auto line = iv.data(0, y0 + yy);
+				if (iv.pixStride() == 1)
+					for (int x = left; x < right; x++)
+						UpdateMinMax(colMin[x], colMax[x], line[x]);
+				else
+					for (int x = left; x < right; x++)
+						UpdateMinMax(colMin[x], colMax[x], line[x * iv.pixStride()]);
+			}
+
+			for (int x = first; x < last; x++) {
+				int x0 = BlockStart(x, iv.width());
+				uint8_t min = 255;
+				uint8_t max = 0;
+				for (int xx = x0; xx < x0 + BLOCK_SIZE; xx++) {
+					min = std::min(min, colMin[xx]);
+					max = std::max(max, colMax[xx]);
+				}
+				bounds.min(x, y) = min;
+				bounds.max(x, y) = max;
 			}
 
-			thresholds(x, y) = (max - min > MIN_DYNAMIC_RANGE) ? (int(max) + min) / 2 : 0;
+			for (int x = 0; x < subWidth; x++)
+				thresholds(x, y) = hasContrast(x, y) ? (int(bounds.max(x, y)) + bounds.min(x, y)) / 2 : 0;
 		}
-	}
+	});
 
 	return thresholds;
 }
@@ -256,27 +346,47 @@ static Matrix<T_t> SmoothThresholds(Matrix<T_t>&& in)
 	return out;
 }
 
-static std::shared_ptr<BitMatrix> ThresholdImage(const ImageView iv, const Matrix<T_t>& thresholds)
+static std::shared_ptr<BitMatrix> ThresholdImage(const ImageView iv, const Matrix<T_t>& thresholds, std::shared_ptr<BitMatrix> matrix,
+												 const ForEachBand& forEachBand)
 {
-	auto matrix = std::make_shared<BitMatrix>(iv.width(), iv.height());
-
 #ifdef PRINT_DEBUG
 	Matrix<uint8_t> out(iv.width(), iv.height());
 #endif
 
-	for (int y = 0; y < thresholds.height(); y++) {
-		int yoffset = std::min(y * BLOCK_SIZE, iv.height() - BLOCK_SIZE);
-		for (int x = 0; x < thresholds.width(); x++) {
-			int xoffset = std::min(x * BLOCK_SIZE, iv.width() - BLOCK_SIZE);
-			ThresholdBlock(iv.data(), xoffset, yoffset, thresholds(x, y), iv.rowStride(), *matrix);
+	// The last block of each row/column is aligned with the right/bottom border and overlaps the previous one, the
+	// pixels in the overlap belong to the last block.
+	auto blockIndex = [](int i, int size, int blocks) { return i >= size - BLOCK_SIZE ? blocks - 1 : i / BLOCK_SIZE; };
+
+	// Instead of thresholding one 8x8 block after the other, expand the block thresholds of a block row to one value
+	// per pixel and threshold full image rows. Those loops are simple enough for the compiler's auto-vectorizer.
+	forEachBand(iv.height(), 64, [&](int begin, int end) {
+		std::vector<T_t> rowThresholds(iv.width());
+
+		for (int y = begin, by = -1; y < end; y++) {
+			if (int i = blockIndex(y, iv.height(), thresholds.height()); i != by) {
+				by = i;
+				for (int x = 0; x < iv.width(); x++)
+					rowThresholds[x] = thresholds(blockIndex(x, iv.width(), thresholds.width()), by);
+			}
+
+			// the loop bounds and pointers are kept in locals, the stores to dst could alias iv and rowThresholds
+			const auto* src = iv.data(0, y);
+			const auto* thrs = rowThresholds.data();
+			auto* dst = matrix->row(y).begin();
+			const int width = iv.width(), pixStride = iv.pixStride();
+			if (pixStride == 1)
+				for (int x = 0; x < width; x++)
+					dst[x] = (src[x] <= thrs[x]) * BitMatrix::SET_V;
+			else
+				for (int x = 0; x < width; x++)
+					dst[x] = (src[x * pixStride] <= thrs[x]) * BitMatrix::SET_V;
 
 #ifdef PRINT_DEBUG
-			for (int yy = 0; yy < 8; ++yy)
-				for (int xx = 0; xx < 8; ++xx)
-					out.set(xoffset + xx, yoffset + yy, thresholds(x, y));
+			for (int x = 0; x < iv.width(); ++x)
+				out.set(x, y, rowThresholds[x]);
 #endif
 		}
-	}
+	});
 
 #ifdef PRINT_DEBUG
 	std::ofstream file("thresholds_new.pnm");
@@ -293,18 +403,27 @@ std::shared_ptr<const BitMatrix> HybridBinarizer::getBlackMatrix() const
 {
 	if (width() >= WINDOW_SIZE && height() >= WINDOW_SIZE) {
 #ifdef USE_NEW_ALGORITHM
-		auto thrs = SmoothThresholds(BlockThresholds(_buffer));
+		auto bands = [this](int count, int minBandSize, const std::function<void(int, int)>& func) {
+			forEachBand(count, minBandSize, func);
+		};
+		auto bounds = std::make_shared<BlockBounds>();
+		auto thrs = SmoothThresholds(BlockThresholds(_buffer, bands, *bounds, _parentBounds.get(), _parentFactor));
+		{
+			std::lock_guard lock(_boundsMutex);
+			_bounds = std::move(bounds);
+		}
 		if (std::ranges::max(thrs) == 0)
 			return GlobalHistogramBinarizer::getBlackMatrix();
-		return ThresholdImage(_buffer, thrs);
+		return ThresholdImage(_buffer, thrs, newBitMatrix(width(), height()), bands);
 #else
 		const uint8_t* luminances = _buffer.data();
 		int subWidth = (width() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(width/BS)
 		int subHeight = (height() + BLOCK_SIZE - 1) / BLOCK_SIZE; // ceil(height/BS)
 		auto blackPoints =
-			CalculateBlackPoints(luminances, subWidth, subHeight, width(), height(), _buffer.rowStride());
+			CalculateBlackPoints(luminances, subWidth, subHeight, width(), height(), _buffer.rowStride(), _buffer.pixStride());
 
-		return CalculateMatrix(luminances, subWidth, subHeight, width(), height(), _buffer.rowStride(), blackPoints);
+		return CalculateMatrix(luminances, subWidth, subHeight, width(), height(), _buffer.rowStride(), _buffer.pixStride(),
+							   blackPoints);
 #endif
 	} else {
 		// If the image is too small, fall back to the global histogram approach.
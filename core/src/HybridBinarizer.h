@@ -8,6 +8,9 @@
 
 #include "GlobalHistogramBinarizer.h"
 
+#include <memory>
+#include <mutex>
+
 namespace ZXing {
 
 /**
@@ -30,11 +33,30 @@ namespace ZXing {
 class HybridBinarizer : public GlobalHistogramBinarizer
 {
 public:
-	explicit HybridBinarizer(const ImageView& iv);
+	struct BlockBounds;
+
+	/**
+	* @param parent  optional bitmap of the image iv has been downscaled from (by box filtering, see LumImagePyramid). If
+	* it has already been binarized, its block statistics are used to skip the blocks without contrast in this one. Only
+	* those can be derived from the parent: the threshold of a block with contrast depends on its exact min and max,
+	* which the box filter changes, so it is still computed from the pixels of iv. A coarser layer can not serve as the
+	* parent of a finer one (see ReaderOptions::coarseToFine), since the averaging may have removed the contrast of thin
+	* features.
+	*/
+	explicit HybridBinarizer(const ImageView& iv, BitMatrixPool* pool = nullptr, ThreadPool* threads = nullptr,
+							 const HybridBinarizer* parent = nullptr);
 	~HybridBinarizer() override;
 
 	bool getPatternRow(int row, int rotation, PatternRow &res) const override;
 	std::shared_ptr<const BitMatrix> getBlackMatrix() const override;
+
+private:
+	std::shared_ptr<const BlockBounds> blockBounds() const;
+
+	mutable std::mutex _boundsMutex;
+	mutable std::shared_ptr<const BlockBounds> _bounds; // of this image, once it has been binarized
+	std::shared_ptr<const BlockBounds> _parentBounds;
+	int _parentFactor = 0;
 };
 
 } // ZXing
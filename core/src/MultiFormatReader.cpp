@@ -8,6 +8,7 @@
 
 #include "BarcodeFormat.h"
 #include "BinaryBitmap.h"
+#include "Deadline.h"
 #include "Reader.h"
 #include "ReaderOptions.h"
 #include "Version.h"
@@ -32,6 +33,7 @@
 #include "qrcode/QRReader.h"
 #endif
 
+#include <algorithm>
 #include <memory>
 
 namespace ZXing {
@@ -47,8 +49,9 @@ MultiFormatReader::MultiFormatReader(const ReaderOptions& opts) : _opts(opts)
 #endif
 
 #if ZXING_ENABLE_QRCODE
+	// the QRCode reader looks for inverted symbols itself, it does not need the inverted image
 	if (opts.hasAnyFormat(QRCode))
-		_readers.emplace_back(new QRCode::Reader(opts, true));
+		_readers.emplace_back(new QRCode::Reader(opts));
 #endif
 #if ZXING_ENABLE_DATAMATRIX
 	if (opts.hasAnyFormat(DataMatrix))
@@ -78,28 +81,69 @@ MultiFormatReader::MultiFormatReader(const ReaderOptions& opts) : _opts(opts)
 
 MultiFormatReader::~MultiFormatReader() = default;
 
-Barcodes MultiFormatReader::read(const BinaryBitmap& image, int maxSymbols) const
+bool MultiFormatReader::supportsInversion() const
 {
-	Barcodes res;
+	return std::any_of(_readers.begin(), _readers.end(), [](const auto& r) { return r->supportsInversion; });
+}
 
-	for (const auto& reader : _readers) {
-		if (image.inverted() && !reader->supportsInversion)
-			continue;
-		auto r = reader->read(image, maxSymbols);
-		if (!_opts.returnErrors())
-			std::erase_if(r, [](auto&& s) { return !s.isValid(); });
-		maxSymbols -= Size(r);
-		res.insert(res.end(), std::move_iterator(r.begin()), std::move_iterator(r.end()));
-		if (maxSymbols <= 0)
-			break;
-	}
+bool MultiFormatReader::usesThreads(int index) const
+{
+	return _readers[index]->usesThreads();
+}
 
+bool MultiFormatReader::truncatesAtMaxSymbols(int index) const
+{
+	return _readers[index]->truncatesAtMaxSymbols();
+}
+
+static void SortByPosition(Barcodes& res)
+{
 	// sort barcodes based on their position on the image
 	std::sort(res.begin(), res.end(), [](const Barcode& l, const Barcode& r) {
 		auto lp = l.position().topLeft();
 		auto rp = r.position().topLeft();
 		return lp.y < rp.y || (lp.y == rp.y && lp.x < rp.x);
 	});
+}
+
+Barcodes MultiFormatReader::read(const BinaryBitmap& image, int index, int maxSymbols) const
+{
+	const auto& reader = _readers[index];
+	if (image.inverted() && !reader->supportsInversion)
+		return {};
+	auto r = reader->read(image, maxSymbols);
+	if (!_opts.returnErrors())
+		std::erase_if(r, [](auto&& s) { return !s.isValid(); });
+	return {std::move_iterator(r.begin()), std::move_iterator(r.end())};
+}
+
+Barcodes MultiFormatReader::read(const BinaryBitmap& image, int maxSymbols) const
+{
+	std::vector<Barcodes> results;
+
+	for (int i = 0, left = maxSymbols; i < size() && left > 0 && !Deadline::Expired(); ++i) {
+		results.push_back(read(image, i, left));
+		left -= Size(results.back());
+	}
+
+	return merge(std::move(results), maxSymbols);
+}
+
+Barcodes MultiFormatReader::merge(std::vector<Barcodes>&& results, int maxSymbols)
+{
+	Barcodes res;
+
+	for (auto& r : results) {
+		if (maxSymbols <= 0)
+			break;
+		// the reader might have been called with a bigger maxSymbols than read(image, maxSymbols) would have passed
+		if (Size(r) > maxSymbols)
+			r.erase(r.begin() + maxSymbols, r.end());
+		maxSymbols -= Size(r);
+		res.insert(res.end(), std::move_iterator(r.begin()), std::move_iterator(r.end()));
+	}
+
+	SortByPosition(res);
 
 	return res;
 }
@@ -26,6 +26,27 @@ public:
 
 	Barcodes read(const BinaryBitmap& image, int maxSymbols = 0xFF) const;
 
+	/// Number of format specific readers, see read(image, index, maxSymbols).
+	int size() const noexcept { return static_cast<int>(_readers.size()); }
+
+	/**
+	 * Run only the format specific reader with the given index on the image. The readers are independent of each
+	 * other, so this can be used to run them in parallel. See merge() to combine the individual results.
+	 */
+	Barcodes read(const BinaryBitmap& image, int index, int maxSymbols) const;
+
+	/// Whether any of the readers needs to see the inverted image if ReaderOptions::tryInvert() is set.
+	bool supportsInversion() const;
+
+	/// Whether the reader with the given index uses the ThreadPool of the image itself, see Reader::usesThreads().
+	bool usesThreads(int index) const;
+
+	/// Whether the reader with the given index may be called with a bigger maxSymbols, see Reader::truncatesAtMaxSymbols().
+	bool truncatesAtMaxSymbols(int index) const;
+
+	/// Combine the results of all readers (in reader order) the same way read(image, maxSymbols) does.
+	static Barcodes merge(std::vector<Barcodes>&& results, int maxSymbols);
+
 private:
 	std::vector<std::unique_ptr<Reader>> _readers;
 	const ReaderOptions& _opts;
@@ -27,29 +27,44 @@ using PatternType = uint16_t;
 template<int N> using Pattern = std::array<PatternType, N>;
 using PatternRow = std::vector<PatternType>;
 
-class PatternView
+/**
+ * @brief BasicPatternView is a view into a PatternRow, either as is (PatternView) or as if it had been reversed
+ * (ReversedPatternView), without modifying the row. The latter is used to look for upside down symbols.
+ */
+template <typename Iterator>
+class BasicPatternView
 {
-	using Iterator = PatternRow::const_pointer;
-	Iterator _data = nullptr;
+	Iterator _data = {};
 	int _size = 0;
-	Iterator _base = nullptr;
-	Iterator _end = nullptr;
+	Iterator _base = {};
+	Iterator _end = {};
+
+	static constexpr bool IS_REVERSED = !std::is_pointer_v<Iterator>;
+
+	static Iterator Begin(const PatternRow& bars)
+	{
+		if constexpr (IS_REVERSED)
+			return Iterator(bars.data() + bars.size());
+		else
+			return bars.data();
+	}
 
 public:
 	using value_type = PatternRow::value_type;
 
-	PatternView() = default;
+	BasicPatternView() = default;
 
 	// A PatternRow always starts with the width of whitespace in front of the first black bar.
-	// The first element of the PatternView is the first bar.
-	PatternView(const PatternRow& bars)
-		: _data(bars.data() + 1), _size(Size(bars) - 1), _base(bars.data()), _end(bars.data() + bars.size())
+	// The first element of the PatternView is the first bar (the last bar of the row for a ReversedPatternView).
+	explicit(IS_REVERSED) BasicPatternView(const PatternRow& bars)
+		: _data(Begin(bars) + 1), _size(Size(bars) - 1), _base(Begin(bars)), _end(Begin(bars) + bars.size())
 	{}
 
-	PatternView(Iterator data, int size, Iterator base, Iterator end) : _data(data), _size(size), _base(base), _end(end) {}
+	BasicPatternView(Iterator data, int size, Iterator base, Iterator end) : _data(data), _size(size), _base(base), _end(end) {}
 
 	template <size_t N>
-	constexpr PatternView(const Pattern<N>& row) : _data(row.data()), _size(N)
+		requires(!IS_REVERSED)
+	constexpr BasicPatternView(const Pattern<N>& row) : _data(row.data()), _size(N)
 	{}
 
 	Iterator data() const { return _data; }
@@ -71,7 +86,7 @@ public:
 	int pixelsTillEnd() const { return Reduce(_base, _data + _size) - 1; }
 	bool isAtFirstBar() const { return _data == _base + 1; }
 	bool isAtLastBar() const { return _data + _size == _end - 1; }
-	bool isValid(int n) const { return _data && _data >= _base && _data + n <= _end; }
+	bool isValid(int n) const { return _data != Iterator{} && _data >= _base && _data + n <= _end; }
 	bool isValid() const { return isValid(size()); }
 	int spaceInFront() const { return isAtFirstBar() ? INT_MAX : _data[-1]; }
 
@@ -87,7 +102,7 @@ public:
 		return (acceptIfAtLastBar && isAtLastBar()) || _data[_size] >= sum() * scale;
 	}
 
-	PatternView subView(int offset, int size = 0) const
+	BasicPatternView subView(int offset, int size = 0) const
 	{
 //		if(std::abs(size) > count())
 //			printf("%d > %d\n", std::abs(size), _count);
@@ -101,7 +116,7 @@ public:
 
 	bool shift(int n)
 	{
-		return _data && ((_data += n) + _size <= _end);
+		return _data != Iterator{} && ((_data += n) + _size <= _end);
 	}
 
 	bool skipPair()
@@ -125,6 +140,9 @@ public:
 	}
 };
 
+using PatternView = BasicPatternView<PatternRow::const_pointer>;
+using ReversedPatternView = BasicPatternView<std::reverse_iterator<PatternRow::const_pointer>>;
+
 /**
  * @brief The BarAndSpace struct is a simple 2 element data structure to hold information about bar(s) and space(s).
  *
@@ -144,7 +162,7 @@ struct BarAndSpace
 using BarAndSpaceI = BarAndSpace<PatternType>;
 
 template <int LEN, typename RT, typename T>
-constexpr auto BarAndSpaceSum(const T* view) noexcept
+constexpr auto BarAndSpaceSum(const T& view) noexcept
 {
 	BarAndSpace<RT> res;
 	for (int i = 0; i < LEN; ++i)
@@ -177,12 +195,13 @@ struct FixedPattern : public Pattern<N>
 template <int N, int SUM>
 using FixedSparsePattern = FixedPattern<N, SUM, true>;
 
-template <bool E2E = false, int LEN, int SUM>
-double IsPattern(const PatternView& view, const FixedPattern<LEN, SUM, false>& pattern, int spaceInPixel = 0,
-				double minQuietZone = 0, double moduleSizeRef = 0)
+// implementation of IsPattern for PatternView and ReversedPatternView
+template <bool E2E, typename View, int LEN, int SUM>
+double IsPatternImpl(const View& view, const FixedPattern<LEN, SUM, false>& pattern, int spaceInPixel, double minQuietZone,
+					 double moduleSizeRef)
 {
 	if constexpr (E2E) {
-		auto widths = BarAndSpaceSum<LEN, double>(view.data());
+		auto widths = BarAndSpaceSum<LEN, double>(view);
 		auto sums = pattern.sums();
 		BarAndSpace<double> modSize = {widths[0] / sums[0], widths[1] / sums[1]};
 
@@ -225,9 +244,9 @@ double IsPattern(const PatternView& view, const FixedPattern<LEN, SUM, false>& p
 	return moduleSize;
 }
 
-template <bool RELAXED_THRESHOLD = false, int N, int SUM>
-double IsPattern(const PatternView& view, const FixedPattern<N, SUM, true>& pattern, int spaceInPixel = 0,
-				 double minQuietZone = 0, double moduleSizeRef = 0)
+template <bool RELAXED_THRESHOLD, typename View, int N, int SUM>
+double IsPatternImpl(const View& view, const FixedPattern<N, SUM, true>& pattern, int spaceInPixel, double minQuietZone,
+					 double moduleSizeRef)
 {
 	// pattern contains the indices with the bars/spaces that need to be equally wide
 	double width = 0;
@@ -253,9 +272,27 @@ double IsPattern(const PatternView& view, const FixedPattern<N, SUM, true>& patt
 	return moduleSize;
 }
 
-template <bool E2E = false, int N, int SUM, bool IS_SPARSE>
-bool IsRightGuard(const PatternView& view, const FixedPattern<N, SUM, IS_SPARSE>& pattern, double minQuietZone,
-				  double moduleSizeRef = 0)
+/**
+ * @brief IsPattern checks if the first elements of view match the pattern and returns the module size (0 if not).
+ *
+ * For a sparse pattern, the template parameter means a relaxed threshold, otherwise it means an edge-to-edge comparison.
+ */
+template <bool E2E = false, int LEN, int SUM, bool IS_SPARSE>
+double IsPattern(const PatternView& view, const FixedPattern<LEN, SUM, IS_SPARSE>& pattern, int spaceInPixel = 0,
+				 double minQuietZone = 0, double moduleSizeRef = 0)
+{
+	return IsPatternImpl<E2E>(view, pattern, spaceInPixel, minQuietZone, moduleSizeRef);
+}
+
+template <bool E2E = false, int LEN, int SUM, bool IS_SPARSE>
+double IsPattern(const ReversedPatternView& view, const FixedPattern<LEN, SUM, IS_SPARSE>& pattern, int spaceInPixel = 0,
+				 double minQuietZone = 0, double moduleSizeRef = 0)
+{
+	return IsPatternImpl<E2E>(view, pattern, spaceInPixel, minQuietZone, moduleSizeRef);
+}
+
+template <bool E2E = false, typename View, int N, int SUM, bool IS_SPARSE>
+bool IsRightGuard(const View& view, const FixedPattern<N, SUM, IS_SPARSE>& pattern, double minQuietZone, double moduleSizeRef = 0)
 {
 	assert(view.size() == pattern.size());
 	if (!view.isValid())
@@ -264,8 +301,31 @@ bool IsRightGuard(const PatternView& view, const FixedPattern<N, SUM, IS_SPARSE>
 	return IsPattern<E2E>(view, pattern, spaceInPixel, minQuietZone, moduleSizeRef) != 0;
 }
 
-template<int LEN, typename Pred>
-PatternView FindLeftGuard(const PatternView& view, int minSize, Pred isGuard)
+/**
+ * @brief QuietZoneRatio returns a lower bound for (spaceInPixel + 1) / (view[0] - 0.5) of any view accepted by
+ * IsPattern<E2E>(view, pattern, spaceInPixel, minQuietZone), or 0 if there is none.
+ *
+ * This allows to rule out most of the positions in a row as a left guard (see FindLeftGuard) by only looking at the
+ * first bar and the space in front of it.
+ */
+template <bool E2E = false, int LEN, int SUM, bool IS_SPARSE>
+constexpr double QuietZoneRatio(const FixedPattern<LEN, SUM, IS_SPARSE>& pattern, double minQuietZone)
+{
+	// the expected width of the first bar in modules (a sparse pattern might not check it at all)
+	int firstBar = IS_SPARSE ? pattern[0] == 0 : pattern[0];
+	if (!firstBar || !minQuietZone)
+		return 0;
+
+	// The returned value is slightly smaller than the derived bound to be on the safe side wrt. rounding errors.
+	if constexpr (E2E) // view[0] <= (firstBar + 0.75) * bar + 0.5, bar <= 4 * space and spaceInPixel >= minQuietZone * space
+		return 0.999 * minQuietZone / (4 * (firstBar + 0.75));
+	else // view[0] <= (firstBar + 0.5) * moduleSize + 0.5 and spaceInPixel >= minQuietZone * moduleSize - 1
+		return 0.999 * minQuietZone / (firstBar + 0.5);
+}
+
+// View is either a PatternView or a ReversedPatternView
+template<int LEN, typename View, typename Pred>
+View FindLeftGuard(const View& view, int minSize, Pred isGuard)
 {
 	if (view.size() < minSize)
 		return {};
@@ -273,21 +333,19 @@ PatternView FindLeftGuard(const PatternView& view, int minSize, Pred isGuard)
 	auto window = view.subView(0, LEN);
 	if (window.isAtFirstBar() && isGuard(window, std::numeric_limits<int>::max()))
 		return window;
-	for (auto end = view.end() - minSize; window.data() < end; window.skipPair())
+	for (int i = 0, end = view.size() - minSize; i < end; i += 2, window.skipPair())
 		if (isGuard(window, window[-1]))
 			return window;
 
 	return {};
 }
 
-template <bool E2E = false, int LEN, int SUM, bool IS_SPARSE>
-PatternView FindLeftGuard(const PatternView& view, int minSize, const FixedPattern<LEN, SUM, IS_SPARSE>& pattern,
-						  double minQuietZone)
+template <bool E2E = false, typename View, int LEN, int SUM, bool IS_SPARSE>
+View FindLeftGuard(const View& view, int minSize, const FixedPattern<LEN, SUM, IS_SPARSE>& pattern, double minQuietZone)
 {
-	return FindLeftGuard<LEN>(view, std::max(minSize, LEN),
-							  [&pattern, minQuietZone](const PatternView& window, int spaceInPixel) {
-								  return IsPattern<E2E>(window, pattern, spaceInPixel, minQuietZone);
-							  });
+	return FindLeftGuard<LEN>(view, std::max(minSize, LEN), [&pattern, minQuietZone](const View& window, int spaceInPixel) {
+		return IsPattern<E2E>(window, pattern, spaceInPixel, minQuietZone);
+	});
 }
 
 template <typename ARRAY, typename = std::enable_if_t<std::is_integral_v<typename ARRAY::value_type>>>
@@ -317,8 +375,8 @@ constexpr uint32_t PackedPattern(const std::array<T, N>& np, T min = 0)
 	return res;
 }
 
-template <int LEN, int RET_LEN>
-constexpr std::array<int, RET_LEN> NormalizedE2EPattern(const PatternView& view, int mods, bool reverse = false)
+template <int LEN, int RET_LEN, typename View>
+constexpr std::array<int, RET_LEN> NormalizedE2EPattern(const View& view, int mods, bool reverse = false)
 {
 	double moduleSize = static_cast<double>(view.sum(LEN)) / mods;
 	std::array<int, RET_LEN> e2e;
@@ -338,6 +396,12 @@ constexpr std::array<int, RET_LEN> NormalizedE2EPattern(const PatternView& view)
 	return NormalizedE2EPattern<LEN, RET_LEN>(view, SUM);
 }
 
+template <int LEN, int SUM, int RET_LEN = LEN - 2>
+constexpr std::array<int, RET_LEN> NormalizedE2EPattern(const ReversedPatternView& view)
+{
+	return NormalizedE2EPattern<LEN, RET_LEN>(view, SUM);
+}
+
 template <int LEN, int SUM, size_t N>
 constexpr auto PatternsToE2EInts(const std::array<FixedPattern<LEN, SUM>, N>& in)
 {
@@ -417,56 +481,76 @@ void GetPatternRow(Range<I> b_row, PatternRow& p_row)
 	if (*lastPos)
 		p_row.push_back(0); // last value is number of white pixels, here 0
 #else
-	p_row.resize(b_row.size() + 2);
-	std::fill(p_row.begin(), p_row.end(), 0);
+	// Instead of counting the pixels of each run, the runs are computed from the positions of the edges. That way the
+	// edges can be found 8 pixels at a time and a long run costs (almost) nothing.
+	const int size = narrow_cast<int>(b_row.size());
+	p_row.resize(size + 2);
 
-	auto bitPos = b_row.begin();
-	const auto bitPosEnd = b_row.end();
+	auto bits = b_row.begin();
 	auto intPos = p_row.data();
+	int runStart = 0; // position of the first pixel of the current run
 
-	if (*bitPos)
-		intPos++; // first value is number of white pixels, here 0
+	if (bits[0])
+		*intPos++ = 0; // first value is number of white pixels, here 0
 
-	// The following code has been observed to cause a speedup of up to 30% on large images on an AVX cpu
-	// and on an a Google Pixel 3 Android phone. Your mileage may vary.
+	int i = 1; // the next pixel to compare with its left neighbor
+
+	// Look at 8 pixel pairs with one xor of two (unaligned) 64-bit words and handle all edges found in them, instead of
+	// reloading after every single edge. That matters for rows with many short runs (1D barcodes). This is plain
+	// integer code, no SIMD instructions are needed.
 	if constexpr (std::contiguous_iterator<I> && sizeof(std::remove_cv_t<std::iter_value_t<I>>) == 1) {
 		using simd_t = uint64_t;
-		const auto* const bitPtrBegin = std::to_address(bitPos);
-		const auto* const bitPtrEnd = std::to_address(bitPosEnd);
-		auto* bitPtr = bitPtrBegin;
-
-		while (bitPtr < bitPtrEnd - sizeof(simd_t)) {
-			auto asSimd0 = LoadU<simd_t>(bitPtr);
-			auto asSimd1 = LoadU<simd_t>(bitPtr + 1);
-			auto z = asSimd0 ^ asSimd1;
-			if (z) {
+		constexpr int N = sizeof(simd_t);
+		constexpr simd_t LSBs = 0x0101010101010101ull; // the lowest bit of every byte
+		const auto* const bitPtr = std::to_address(bits);
+
+		for (; i + N <= size; i += N) {
+			// one bit per pixel pair, set if the pixels i + k - 1 and i + k differ (values are either 0 or 0xff)
+			auto edges = (LoadU<simd_t>(bitPtr + i - 1) ^ LoadU<simd_t>(bitPtr + i)) & LSBs;
+			while (edges) {
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-				int step = std::countr_zero(z) / 8 + 1;
+				int edge = i + std::countr_zero(edges) / 8;
+				edges &= edges - 1;
 #else
-				int step = std::countl_zero(z) / 8 + 1;
+				int edge = i + std::countl_zero(edges) / 8;
+				edges ^= simd_t(1) << (63 - std::countl_zero(edges));
 #endif
-				(*intPos++) += step;
-				bitPtr += step;
-			} else {
-				(*intPos) += sizeof(simd_t);
-				bitPtr += sizeof(simd_t);
+				*intPos++ = edge - runStart;
+				runStart = edge;
 			}
 		}
-
-		bitPos += bitPtr - bitPtrBegin;
 	}
 
-	while (++bitPos != bitPosEnd) {
-		++(*intPos);
-		intPos += bitPos[0] != bitPos[-1];
+	for (; i < size; ++i) {
+		bool edge = bits[i] != bits[i - 1];
+		*intPos = i - runStart;
+		intPos += edge;
+		runStart = edge ? i : runStart;
 	}
-	++(*intPos);
+	*intPos++ = size - runStart;
 
-	if (bitPos[-1])
-		intPos++;
+	if (bits[size - 1])
+		*intPos++ = 0; // last value is number of white pixels, here 0
 
-	p_row.resize(intPos - p_row.data() + 1);
+	p_row.resize(intPos - p_row.data());
 #endif
 }
 
+/**
+ * @brief InvertPatternRow turns p_row into the pattern row of the inverted input row.
+ *
+ * The run lengths stay the same, only the leading and trailing white run (possibly 0) change.
+ */
+inline void InvertPatternRow(PatternRow& p_row)
+{
+	if (p_row.front() == 0)
+		p_row.erase(p_row.begin());
+	else
+		p_row.insert(p_row.begin(), 0);
+	if (p_row.back() == 0)
+		p_row.pop_back();
+	else
+		p_row.push_back(0);
+}
+
 } // ZXing
@@ -12,16 +12,26 @@
 
 
 #ifdef ZXING_READERS
+#include "AdaptiveBinarizer.h"
+#include "Deadline.h"
 #include "GlobalHistogramBinarizer.h"
 #include "HybridBinarizer.h"
 #include "MultiFormatReader.h"
 #include "Pattern.h"
+#include "StdScope.h"
+#include "ThreadPool.h"
 #include "ThresholdBinarizer.h"
+#include "ZXConfig.h"
 #endif
 
+#include <atomic>
 #include <climits>
 #include <memory>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
 
 namespace ZXing {
 
@@ -35,6 +45,8 @@ struct ReaderOptions::Data
 	bool tryRotate                : 1 = true;
 	bool tryInvert                : 1 = true;
 	bool tryDownscale             : 1 = true;
+	bool tryOblique               : 1 = false;
+	bool coarseToFine             : 1 = false;
 #ifdef ZXING_EXPERIMENTAL_API
 	bool tryDenoise               : 1 = false;
 #endif
@@ -43,14 +55,18 @@ struct ReaderOptions::Data
 	bool returnErrors             : 1 = false;
 	uint8_t downscaleFactor       : 3 = 3; // values 2, 3, 4
 	EanAddOnSymbol eanAddOnSymbol : 2 = EanAddOnSymbol::Ignore;
-	Binarizer binarizer           : 2 = Binarizer::LocalAverage;
+	Binarizer binarizer           : 3 = Binarizer::LocalAverage;
 	TextMode textMode             : 3 = TextMode::HRI;
 	CharacterSet characterSet     : 6 = CharacterSet::Unknown;
 
 	uint8_t minLineCount          = 2;
 	uint8_t maxNumberOfSymbols    = 0xff;
+	uint8_t maxThreads            = 1;
 	uint16_t downscaleThreshold   = 500;
+	uint16_t binarizerWindow      = 0;
+	std::chrono::microseconds timeBudget = {};
 	BarcodeFormats formats        = {};
+	std::vector<Rect> regionsOfInterest = {};
 };
 
 ReaderOptions::ReaderOptions() : d(std::make_unique<Data>()) {}
@@ -73,6 +89,10 @@ const BarcodeFormats& ReaderOptions::formats() const noexcept { return d->format
 ReaderOptions& ReaderOptions::formats(BarcodeFormats&& v) & { return (void)(d->formats = std::move(v)), *this; }
 ReaderOptions&& ReaderOptions::formats(BarcodeFormats&& v) && { return (void)(d->formats = std::move(v)), std::move(*this); }
 
+const std::vector<Rect>& ReaderOptions::regionsOfInterest() const noexcept { return d->regionsOfInterest; }
+ReaderOptions& ReaderOptions::regionsOfInterest(std::vector<Rect> v) & { return (void)(d->regionsOfInterest = std::move(v)), *this; }
+ReaderOptions&& ReaderOptions::regionsOfInterest(std::vector<Rect> v) && { return (void)(d->regionsOfInterest = std::move(v)), std::move(*this); }
+
 #define ZX_PROPERTY(TYPE, NAME, SETTER) \
 	TYPE ReaderOptions::NAME() const noexcept { return d->NAME; } \
 	ReaderOptions& ReaderOptions::NAME(TYPE v) & { return (void)(d->NAME = std::move(v)), *this; } \
@@ -82,15 +102,20 @@ ZX_PROPERTY(bool, tryHarder, setTryHarder)
 ZX_PROPERTY(bool, tryRotate, setTryRotate)
 ZX_PROPERTY(bool, tryInvert, setTryInvert)
 ZX_PROPERTY(bool, tryDownscale, setTryDownscale)
+ZX_PROPERTY(bool, tryOblique, setTryOblique)
+ZX_PROPERTY(bool, coarseToFine, setCoarseToFine)
 #ifdef ZXING_EXPERIMENTAL_API
 ZX_PROPERTY(bool, tryDenoise, setTryDenoise)
 #endif
 ZX_PROPERTY(Binarizer, binarizer, setBinarizer)
+ZX_PROPERTY(uint16_t, binarizerWindow, setBinarizerWindow)
 ZX_PROPERTY(bool, isPure, setIsPure)
 ZX_PROPERTY(uint16_t, downscaleThreshold, setDownscaleThreshold)
 ZX_PROPERTY(uint8_t, downscaleFactor, setDownscaleFactor)
 ZX_PROPERTY(uint8_t, minLineCount, setMinLineCount)
 ZX_PROPERTY(uint8_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
+ZX_PROPERTY(uint8_t, maxThreads, setMaxThreads)
+ZX_PROPERTY(std::chrono::microseconds, timeBudget, setTimeBudget)
 ZX_PROPERTY(bool, validateOptionalChecksum, setValidateOptionalChecksum)
 ZX_PROPERTY(bool, returnErrors, setReturnErrors)
 ZX_PROPERTY(EanAddOnSymbol, eanAddOnSymbol, setEanAddOnSymbol)
@@ -134,118 +159,367 @@ public:
 	uint8_t* data() { return const_cast<uint8_t*>(Image::data()); }
 };
 
+// (re-)allocate the image memory only if the size changed
+static void Resize(LumImage& img, int width, int height)
+{
+	if (img.width() != width || img.height() != height)
+		img = LumImage(width, height);
+}
+
+template<typename P>
+static void ExtractLumRow(const ImageView& iv, int y, uint8_t* dst, P projection)
+{
+	// the source pointer and stride are kept in locals, since the stores to dst could alias the members of iv
+	const uint8_t* src = iv.data(0, y);
+	for (int x = 0, w = iv.width(), stride = iv.pixStride(); x < w; ++x)
+		dst[x] = projection(src + x * stride);
+}
+
 template<typename P>
-static LumImage ExtractLum(const ImageView& iv, P projection)
+static const LumImage& ExtractLum(const ImageView& iv, LumImage& res, P projection)
 {
-	LumImage res(iv.width(), iv.height());
+	Resize(res, iv.width(), iv.height());
 
-	auto* dst = res.data();
 	for(int y = 0; y < iv.height(); ++y)
-		for(int x = 0, w = iv.width(); x < w; ++x)
-			*dst++ = projection(iv.data(x, y));
+		ExtractLumRow(iv, y, res.data() + y * res.width(), projection);
 
 	return res;
 }
 
+// Calls func(projection) with the function converting a pixel of iv to luminance if the binarizer needs a separate
+// luminance image. Returns false if iv can be used as is.
+template <typename F>
+static bool WithLumProjection(const ImageView& iv, const ReaderOptions& opts, F&& func)
+{
+	if (iv.format() == ImageFormat::None)
+		throw std::invalid_argument("Invalid image format");
+
+	if (opts.binarizer() == Binarizer::GlobalHistogram || opts.binarizer() == Binarizer::LocalAverage
+		|| opts.binarizer() == Binarizer::Adaptive) {
+		// manually spell out the 3 most common pixel formats to get at least gcc to vectorize the code
+		if (iv.format() == ImageFormat::RGB && iv.pixStride() == 3) {
+			func([](const uint8_t* src) { return RGBToLum(src[0], src[1], src[2]); });
+		} else if (iv.format() == ImageFormat::RGBA && iv.pixStride() == 4) {
+			func([](const uint8_t* src) { return RGBToLum(src[0], src[1], src[2]); });
+		} else if (iv.format() == ImageFormat::BGR && iv.pixStride() == 3) {
+			func([](const uint8_t* src) { return RGBToLum(src[2], src[1], src[0]); });
+		} else if (iv.format() != ImageFormat::Lum && iv.format() != ImageFormat::LumA) {
+			func([r = RedIndex(iv.format()), g = GreenIndex(iv.format()), b = BlueIndex(iv.format())](
+					 const uint8_t* src) { return RGBToLum(src[r], src[g], src[b]); });
+		} else {
+			// GlobalHistogram, LocalAverage and Adaptive work directly on interleaved luminance data (LumA, YUYV, ...)
+			return false;
+		}
+		return true;
+	}
+	return false;
+}
+
+ImageView SetupLumImageView(ImageView iv, LumImage& lum, const ReaderOptions& opts)
+{
+	if (WithLumProjection(iv, opts, [&](auto projection) { ExtractLum(iv, lum, projection); }))
+		return lum;
+	return iv;
+}
+
+// average N x N blocks of N rows of the (dense) source into one row of the destination
+template <int N>
+static void DownscaleRow(const uint8_t* src, int srcStride, uint8_t* dst, int dstWidth)
+{
+	for (int dx = 0; dx < dstWidth; ++dx, src += N) {
+		int sum = (N * N) / 2;
+		for (int ty = 0; ty < N; ++ty)
+			for (int tx = 0; tx < N; ++tx)
+				sum += src[ty * srcStride + tx];
+		dst[dx] = sum / (N * N);
+	}
+}
+
+// average factor x factor blocks of the rows [dy * factor, (dy + 1) * factor) of the source into one row of dst
+static void DownscaleRow(int factor, const ImageView& src, int dy, uint8_t* dst, int dstWidth)
+{
+	if (src.pixStride() == 1) {
+		// help the compiler's auto-vectorizer by hard-coding the scale factor
+		const uint8_t* s = src.data(0, dy * factor);
+		switch (factor) {
+		case 2: return DownscaleRow<2>(s, src.rowStride(), dst, dstWidth);
+		case 3: return DownscaleRow<3>(s, src.rowStride(), dst, dstWidth);
+		case 4: return DownscaleRow<4>(s, src.rowStride(), dst, dstWidth);
+		}
+	}
+
+	for (int dx = 0; dx < dstWidth; ++dx) {
+		int sum = (factor * factor) / 2;
+		for (int ty = 0; ty < factor; ++ty)
+			for (int tx = 0; tx < factor; ++tx)
+				sum += *src.data(dx * factor + tx, dy * factor + ty);
+		dst[dx] = sum / (factor * factor);
+	}
+}
+
 class LumImagePyramid
 {
 	std::vector<LumImage> buffers;
 
-	template<int N>
-	void addLayer()
+	// a new (uninitialized) layer, downscaled from the current smallest one
+	LumImage& newLayer(int factor)
 	{
 		auto siv = layers.back();
-		buffers.emplace_back(siv.width() / N, siv.height() / N);
-		layers.push_back(buffers.back());
-		auto& div = buffers.back();
-		auto* d   = div.data();
-
-		for (int dy = 0; dy < div.height(); ++dy)
-			for (int dx = 0; dx < div.width(); ++dx) {
-				int sum = (N * N) / 2;
-				for (int ty = 0; ty < N; ++ty)
-					for (int tx = 0; tx < N; ++tx)
-						sum += *siv.data(dx * N + tx, dy * N + ty);
-				*d++ = sum / (N * N);
-			}
+		if (buffers.size() < layers.size())
+			buffers.emplace_back();
+		auto& div = buffers[layers.size() - 1];
+		Resize(div, siv.width() / factor, siv.height() / factor);
+		layers.push_back(div);
+		return div;
 	}
 
-	void addLayer(int factor)
+	bool needsLayer(int threshold, int factor) const
 	{
-		// help the compiler's auto-vectorizer by hard-coding the scale factor
-		switch (factor) {
-		case 2: addLayer<2>(); break;
-		case 3: addLayer<3>(); break;
-		case 4: addLayer<4>(); break;
-		default: throw std::invalid_argument("Invalid ReaderOptions::downscaleFactor"); break;
+		// TODO: if only matrix codes were considered, then using std::min would be sufficient (see #425)
+		return threshold > 0 && std::max(layers.back().width(), layers.back().height()) > threshold &&
+			   std::min(layers.back().width(), layers.back().height()) >= factor;
+	}
+
+	// the layers are allocated up front, so they can be filled in one pass over the full resolution image
+	void addLayers(int threshold, int factor)
+	{
+		if (factor < 2)
+			throw std::invalid_argument("Invalid ReaderOptions::downscaleFactor");
+
+		while (needsLayer(threshold, factor)) {
+			if (factor > 4)
+				throw std::invalid_argument("Invalid ReaderOptions::downscaleFactor");
+			newLayer(factor);
 		}
 	}
 
+	// Called after row y of layer l is complete. If that completes a band of factor rows, it is downscaled into the
+	// next layer right away (while it is still in the cache), which in turn may complete a band there, and so on.
+	void rowDone(int l, int y, int factor)
+	{
+		if (l + 1 >= Size(layers) || y % factor != factor - 1 || y / factor >= layers[l + 1].height())
+			return;
+
+		auto& div = buffers[l]; // the buffer of layer l + 1
+		DownscaleRow(factor, layers[l], y / factor, div.data() + y / factor * div.width(), div.width());
+		rowDone(l + 1, y / factor, factor);
+	}
+
+	void finish(bool smallestFirst)
+	{
+		// Reversing the layers means we start with the smallest. That can make sense if we are only looking for a
+		// single symbol or if symbols found in a lower res layer are masked out of the higher res ones (see
+		// ReaderOptions::coarseToFine). If we start with the higher resolution, we get better position information.
+		if (smallestFirst)
+			std::reverse(layers.begin(), layers.end());
+	}
+
 public:
 	std::vector<ImageView> layers;
 
-	LumImagePyramid(const ImageView& iv, int threshold, int factor)
+	// (re-)build the pyramid, reusing the buffers of the previous call
+	void build(const ImageView& iv, int threshold, int factor, bool smallestFirst = false)
 	{
-		if (factor < 2)
-			throw std::invalid_argument("Invalid ReaderOptions::downscaleFactor");
-
+		layers.clear();
 		layers.push_back(iv);
-		// TODO: if only matrix codes were considered, then using std::min would be sufficient (see #425)
-		while (threshold > 0 && std::max(layers.back().width(), layers.back().height()) > threshold &&
-			   std::min(layers.back().width(), layers.back().height()) >= factor)
-			addLayer(factor);
-#if 0
-		// Reversing the layers means we'd start with the smallest. that can make sense if we are only looking for a
-		// single symbol. If we start with the higher resolution, we get better (high res) position information.
-		// TODO: see if masking out higher res layers based on found symbols in lower res helps overall performance.
-		std::reverse(layers.begin(), layers.end());
-#endif
+		addLayers(threshold, factor);
+
+		for (int y = 0; y < iv.height(); ++y)
+			rowDone(0, y, factor);
+
+		finish(smallestFirst);
+	}
+
+	// Same as build(SetupLumImageView(iv, lum, opts), ...) but fusing the luminance conversion with the generation of
+	// the downscaled layers: every band of rows is downscaled right after its conversion, while it is still in the
+	// cache, instead of reading the full resolution luminance image from memory again.
+	void build(const ImageView& iv, LumImage& lum, const ReaderOptions& opts, int threshold, int factor, bool smallestFirst = false)
+	{
+		bool converted = WithLumProjection(iv, opts, [&](auto projection) {
+			Resize(lum, iv.width(), iv.height());
+			layers.clear();
+			layers.push_back(lum);
+			addLayers(threshold, factor);
+
+			for (int y = 0; y < iv.height(); ++y) {
+				ExtractLumRow(iv, y, lum.data() + y * lum.width(), projection);
+				rowDone(0, y, factor);
+			}
+		});
+
+		if (converted)
+			finish(smallestFirst);
+		else
+			build(iv, threshold, factor, smallestFirst);
 	}
 };
 
-ImageView SetupLumImageView(ImageView iv, LumImage& lum, const ReaderOptions& opts)
+// Fill everything outside of the given regions with white, so the detectors have nothing to look at there. If iv
+// does not already refer to the lum buffer, its (green channel) content is copied first.
+static ImageView KeepRegions(const ImageView& iv, LumImage& lum, const std::vector<Rect>& regions)
 {
-	if (iv.format() == ImageFormat::None)
-		throw std::invalid_argument("Invalid image format");
-
-	if (opts.binarizer() == Binarizer::GlobalHistogram || opts.binarizer() == Binarizer::LocalAverage) {
-		// manually spell out the 3 most common pixel formats to get at least gcc to vectorize the code
-		if (iv.format() == ImageFormat::RGB && iv.pixStride() == 3) {
-			lum = ExtractLum(iv, [](const uint8_t* src) { return RGBToLum(src[0], src[1], src[2]); });
-		} else if (iv.format() == ImageFormat::RGBA && iv.pixStride() == 4) {
-			lum = ExtractLum(iv, [](const uint8_t* src) { return RGBToLum(src[0], src[1], src[2]); });
-		} else if (iv.format() == ImageFormat::BGR && iv.pixStride() == 3) {
-			lum = ExtractLum(iv, [](const uint8_t* src) { return RGBToLum(src[2], src[1], src[0]); });
-		} else if (iv.format() != ImageFormat::Lum) {
-			lum = ExtractLum(iv, [r = RedIndex(iv.format()), g = GreenIndex(iv.format()), b = BlueIndex(iv.format())](
-									 const uint8_t* src) { return RGBToLum(src[r], src[g], src[b]); });
-		} else if (iv.pixStride() != 1) {
-			// GlobalHistogram and LocalAverage need dense line memory layout
-			lum = ExtractLum(iv, [](const uint8_t* src) { return *src; });
+	if (iv.data() != lum.data())
+		ExtractLum(iv, lum, [g = GreenIndex(iv.format())](const uint8_t* src) { return src[g]; });
+
+	std::vector<std::pair<int, int>> spans; // the [begin, end) x-ranges of the regions intersecting one row
+	for (int y = 0; y < lum.height(); ++y) {
+		spans.clear();
+		for (auto& r : regions)
+			if (r.top <= y && y < r.top + r.height)
+				spans.emplace_back(std::clamp(r.left, 0, lum.width()), std::clamp(r.left + r.width, 0, lum.width()));
+		std::sort(spans.begin(), spans.end());
+
+		auto* row = lum.data() + y * lum.width();
+		int x = 0;
+		for (auto [begin, end] : spans) {
+			if (begin > x)
+				std::fill(row + x, row + begin, 255);
+			x = std::max(x, end);
 		}
-		if (lum.data())
-			return lum;
+		std::fill(row + x, row + lum.width(), 255);
 	}
-	return iv;
+
+	return lum;
+}
+
+// Hide the valid matrix codes found so far from the detectors, see ReaderOptions::coarseToFine. Linear codes are
+// not masked, since the 1D reader works on the luminance rows and not on the bit matrix.
+static void MaskFoundSymbols(BinaryBitmap& bitmap, const Barcodes& barcodes, int scale)
+{
+	std::vector<QuadrilateralF> regions;
+	for (auto& b : barcodes) {
+		if (!b.isValid() || (b.format() & BarcodeFormat::AllLinear))
+			continue;
+		// the positions are in full resolution coordinates, also cover some of the quiet zone (and position error)
+		QuadrilateralF q;
+		for (int i = 0; i < 4; ++i)
+			q[i] = PointF(b.position()[i]) / scale;
+		auto c = Center(q);
+		for (auto& p : q)
+			p = c + 1.2 * (p - c);
+		regions.push_back(q);
+	}
+
+	if (!regions.empty())
+		bitmap.mask(regions);
 }
 
-std::unique_ptr<BinaryBitmap> CreateBitmap(ZXing::Binarizer binarizer, const ImageView& iv)
+// parent is the bitmap of the previous pyramid layer (if any), iv has been downscaled from, see HybridBinarizer
+// scale is the downscale factor of iv relative to the input image, see ReaderOptions::binarizerWindow()
+std::unique_ptr<BinaryBitmap> CreateBitmap(const ReaderOptions& opts, const ImageView& iv, int scale, BitMatrixPool* pool = nullptr,
+										   ThreadPool* threads = nullptr, const BinaryBitmap* parent = nullptr)
 {
-	switch (binarizer) {
-	case Binarizer::BoolCast: return std::make_unique<ThresholdBinarizer>(iv, 0);
-	case Binarizer::FixedThreshold: return std::make_unique<ThresholdBinarizer>(iv, 127);
-	case Binarizer::GlobalHistogram: return std::make_unique<GlobalHistogramBinarizer>(iv);
-	case Binarizer::LocalAverage: return std::make_unique<HybridBinarizer>(iv);
+	switch (opts.binarizer()) {
+	case Binarizer::BoolCast: return std::make_unique<ThresholdBinarizer>(iv, 0, pool, threads);
+	case Binarizer::FixedThreshold: return std::make_unique<ThresholdBinarizer>(iv, 127, pool, threads);
+	case Binarizer::GlobalHistogram: return std::make_unique<GlobalHistogramBinarizer>(iv, pool, threads);
+	case Binarizer::LocalAverage:
+		return std::make_unique<HybridBinarizer>(iv, pool, threads, dynamic_cast<const HybridBinarizer*>(parent));
+	case Binarizer::Adaptive:
+		return std::make_unique<AdaptiveBinarizer>(iv, pool, threads,
+												   opts.binarizerWindow() ? std::max(1, opts.binarizerWindow() / scale) : 0);
 	}
 	return {}; // silence gcc warning
 }
 
-Barcode ReadBarcode(const ImageView& _iv, const ReaderOptions& opts)
+// ==============================================================================
+// ReaderSession implementation
+// ==============================================================================
+
+#define ZX_STRINGIFY_IMPL(x) #x
+#define ZX_STRINGIFY(x) ZX_STRINGIFY_IMPL(x)
+
+// The scratch buffers declared ZX_THREAD_LOCAL (see ZXConfig.h) are shared by all threads unless they are thread_local,
+// without that the readers must not run on the workers of a ThreadPool.
+static constexpr bool ThreadLocalScratchBuffers = std::string_view(ZX_STRINGIFY(ZX_THREAD_LOCAL)) == "thread_local";
+
+#undef ZX_STRINGIFY
+#undef ZX_STRINGIFY_IMPL
+
+struct ReaderSession::Data
 {
-	return FirstOrDefault(ReadBarcodes(_iv, ReaderOptions(opts).maxNumberOfSymbols(1)));
+	ReaderOptions opts;
+	MultiFormatReader reader;
+	std::unique_ptr<MultiFormatReader> closedReader;
+#ifdef ZXING_EXPERIMENTAL_API
+	ReaderOptions closedOptions;
+#endif
+
+	// scratch memory that is reused between calls to read()
+	LumImage lum;
+	LumImagePyramid pyramid;
+	BitMatrixPool matrixPool;
+
+	std::unique_ptr<ThreadPool> threadPool; // only present if opts.maxThreads() != 1 (and ThreadLocalScratchBuffers)
+
+	std::atomic<bool> cancelled = false; // see cancel()
+	bool partial = false; // see partial()
+
+	// state of the tracking mode, see track()
+	struct Tracking
+	{
+		Barcodes barcodes; // found in the previous frame
+		int frames = 0; // since the last full search
+		std::unique_ptr<ReaderSession> session; // restricted to the formats of the tracked barcodes
+	} tracking;
+
+	explicit Data(const ReaderOptions& o) : opts(o), reader(opts)
+	{
+		if (opts.maxThreads() != 1 && ThreadLocalScratchBuffers)
+			threadPool = std::make_unique<ThreadPool>(opts.maxThreads());
+
+#ifdef ZXING_EXPERIMENTAL_API
+		using enum BarcodeFormat;
+		BarcodeFormats formatsBenefittingFromClosing = Aztec | DataMatrix | QRCode;
+		if (opts.tryDenoise() && opts.hasAnyFormat(formatsBenefittingFromClosing)) {
+			closedOptions = opts;
+			closedOptions.formats(opts.formats().empty() ? formatsBenefittingFromClosing
+														 : formatsBenefittingFromClosing & opts.formats());
+			// the closed image is never inverted, that includes the readers that handle inverted symbols themselves
+			closedOptions.tryInvert(false);
+			closedReader = std::make_unique<MultiFormatReader>(closedOptions);
+		}
+#endif
+	}
+
+	Barcodes read(const ImageView& iv);
+	Barcodes readRegions(const ImageView& iv, const std::vector<Rect>& regions);
+};
+
+ReaderSession::ReaderSession(const ReaderOptions& options) : d(std::make_unique<Data>(options)) {}
+ReaderSession::~ReaderSession() = default;
+ReaderSession::ReaderSession(ReaderSession&&) noexcept = default;
+ReaderSession& ReaderSession::operator=(ReaderSession&&) noexcept = default;
+
+const ReaderOptions& ReaderSession::options() const noexcept
+{
+	return d->opts;
 }
 
-Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
+void ReaderSession::cancel() noexcept
+{
+	d->cancelled = true;
+}
+
+bool ReaderSession::partial() const noexcept
+{
+	return d->partial;
+}
+
+Barcodes ReaderSession::read(const ImageView& iv)
+{
+	// a cancel() that arrives before the call starts applies to it, so the flag is only reset once the call returns
+	SCOPE_EXIT([this] { d->cancelled = false; });
+	Deadline deadline(d->opts.timeBudget(), &d->cancelled);
+	Deadline::Scope scope(deadline);
+
+	auto res = d->read(iv);
+
+	d->partial = deadline.reached();
+	return res;
+}
+
+Barcodes ReaderSession::Data::read(const ImageView& _iv)
 {
 	if (sizeof(PatternType) < 4 && (_iv.width() > 0xffff || _iv.height() > 0xffff))
 		throw std::invalid_argument("Maximum image width/height is 65535");
@@ -253,56 +527,296 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 	if (!_iv.data() || _iv.width() * _iv.height() == 0)
 		throw std::invalid_argument("ImageView is null/empty");
 
-	LumImage lum;
-	ImageView iv = SetupLumImageView(_iv, lum, opts);
-	MultiFormatReader reader(opts);
+	const auto& rois = opts.regionsOfInterest();
+	if (rois.empty())
+		return readRegions(_iv, {});
+
+	// crop the image to the bounding box of all regions (clipped to the image)
+	int left = _iv.width(), top = _iv.height(), right = 0, bottom = 0;
+	for (auto& r : rois) {
+		left = std::min(left, std::max(r.left, 0));
+		top = std::min(top, std::max(r.top, 0));
+		right = std::max(right, std::min(r.left + r.width, _iv.width()));
+		bottom = std::max(bottom, std::min(r.top + r.height, _iv.height()));
+	}
+	if (left >= right || top >= bottom)
+		return {};
 
-	if (opts.isPure())
-		return {FirstOrDefault(reader.read(*CreateBitmap(opts.binarizer(), iv), 1)).setReaderOptions(opts)};
+	// with more than one region, the parts of the bounding box outside of the regions need to be hidden
+	std::vector<Rect> regions;
+	if (rois.size() > 1)
+		for (auto& r : rois)
+			regions.push_back({r.left - left, r.top - top, r.width, r.height});
 
-	std::unique_ptr<MultiFormatReader> closedReader;
-#ifdef ZXING_EXPERIMENTAL_API
-	using enum BarcodeFormat;
-	BarcodeFormats formatsBenefittingFromClosing = Aztec | DataMatrix | QRCode;
-	ReaderOptions closedOptions = opts;
-	if (opts.tryDenoise() && opts.hasAnyFormat(formatsBenefittingFromClosing) && _iv.height() >= 3) {
-		closedOptions.formats(opts.formats().empty() ? formatsBenefittingFromClosing : formatsBenefittingFromClosing & opts.formats());
-		closedReader = std::make_unique<MultiFormatReader>(closedOptions);
+	auto res = readRegions(_iv.cropped(left, top, right - left, bottom - top), regions);
+
+	for (auto& r : res)
+		r.d->position = Move(r.position(), PointI(left, top));
+
+	return res;
+}
+
+Barcodes ReaderSession::track(const ImageView& iv, int fullSearchInterval)
+{
+	auto& t = d->tracking;
+
+	SCOPE_EXIT([this] { d->cancelled = false; }); // see read()
+	Deadline deadline(d->opts.timeBudget(), &d->cancelled);
+	Deadline::Scope scope(deadline);
+	auto finish = [&](Barcodes res) {
+		d->partial = deadline.reached();
+		return res;
+	};
+
+	if (!t.barcodes.empty() && ++t.frames < fullSearchInterval) {
+		// the windows are clipped to the regions of interest (the inner session has none), like the full search
+		auto rois = d->opts.regionsOfInterest();
+		if (rois.empty())
+			rois.push_back({0, 0, iv.width(), iv.height()});
+
+		Barcodes res;
+		bool lost = false;
+		for (auto& prev : t.barcodes) {
+			// the inner session checks our deadline as well
+			if (Deadline::Expired())
+				return finish(std::move(res));
+
+			// search a window around the previous position, big enough to cover the movement between two frames
+			auto bb = BoundingBox(prev.position());
+			auto size = bb.bottomRight() - bb.topLeft();
+			int margin = std::max(size.x, size.y) / 4 + 8;
+
+			bool found = false;
+			for (auto& roi : rois) {
+				int left = std::max({0, roi.left, bb.topLeft().x - margin});
+				int top = std::max({0, roi.top, bb.topLeft().y - margin});
+				int right = std::min({iv.width(), roi.left + roi.width, bb.bottomRight().x + margin});
+				int bottom = std::min({iv.height(), roi.top + roi.height, bb.bottomRight().y + margin});
+				if (left >= right || top >= bottom)
+					continue;
+
+				for (auto& r : t.session->read(iv.cropped(left, top, right - left, bottom - top))) {
+					r.d->position = Move(r.position(), PointI(left, top));
+					found |= r.format() == prev.format() && r.bytes() == prev.bytes();
+					if (!Contains(res, r))
+						res.push_back(std::move(r));
+				}
+			}
+			if (!found) {
+				lost = true;
+				break;
+			}
+		}
+		if (!lost)
+			return finish(t.barcodes = std::move(res));
 	}
-#endif
-	LumImagePyramid pyramid(iv, opts.downscaleThreshold() * opts.tryDownscale(), opts.downscaleFactor());
+
+	auto res = d->read(iv);
+
+	t.frames = 0;
+	t.barcodes = res;
+	if (!res.empty()) {
+		std::vector<BarcodeFormat> formats;
+		for (auto& r : res)
+			formats.push_back(r.format());
+		BarcodeFormats trackedFormats(std::move(formats));
+		if (!t.session || t.session->options().formats() != trackedFormats)
+			t.session = std::make_unique<ReaderSession>(
+				ReaderOptions(d->opts).formats(trackedFormats).regionsOfInterest({}).coarseToFine(false).maxThreads(1).timeBudget({}));
+	}
+
+	return finish(std::move(res));
+}
+
+Barcodes ReaderSession::Data::readRegions(const ImageView& _iv, const std::vector<Rect>& regions)
+{
+	const int threshold = opts.downscaleThreshold() * opts.tryDownscale();
+
+	if (opts.isPure() || !regions.empty()) {
+		ImageView iv = SetupLumImageView(_iv, lum, opts);
+		if (!regions.empty())
+			iv = KeepRegions(iv, lum, regions);
+
+		if (opts.isPure())
+			return {FirstOrDefault(reader.read(*CreateBitmap(opts, iv, 1, &matrixPool), 1)).setReaderOptions(opts)};
+
+		pyramid.build(iv, threshold, opts.downscaleFactor(), opts.coarseToFine());
+	} else {
+		pyramid.build(_iv, lum, opts, threshold, opts.downscaleFactor(), opts.coarseToFine());
+	}
+
+	MultiFormatReader* closedReader = _iv.height() >= 3 ? this->closedReader.get() : nullptr;
+	// the inverted pass is only needed for readers that can not look for inverted symbols in the normal image
+	const bool tryInvert = opts.tryInvert() && reader.supportsInversion();
+	const auto& layers = pyramid.layers;
 
 	Barcodes res;
 	int maxSymbols = opts.maxNumberOfSymbols() ? opts.maxNumberOfSymbols() : INT_MAX;
-	for (auto&& iv : pyramid.layers) {
-		auto bitmap = CreateBitmap(opts.binarizer(), iv);
-		for (int close = 0; close <= (closedReader ? 1 : 0); ++close) {
-			if (close) {
-				// if we already inverted the image in the first round, we need to undo that first
-				if (bitmap->inverted())
-					bitmap->invert();
-				bitmap->close();
+
+	// merge the results of one pass into res, returns false if maxSymbols has been reached
+	auto addResults = [&](Barcodes&& rs, const ImageView& iv, bool inverted) {
+		for (auto& r : rs) {
+			if (iv.width() != _iv.width())
+				r.d->position = Scale(r.position(), _iv.width() / iv.width());
+			if (!Contains(res, r)) {
+				r.setReaderOptions(opts);
+				r.d->isInverted |= inverted;
+				res.push_back(std::move(r));
+				--maxSymbols;
+			}
+		}
+		return maxSymbols > 0;
+	};
+
+	if (threadPool && threadPool->size() > 1) {
+		// The normal and the inverted passes of all layers of a round and all their individual readers run concurrently.
+		// Each layer is binarized only once, its bitmap is inverted in between. The results are merged in the same
+		// order as in the serial code below: per layer the normal, the inverted and then the closed pass. The closed
+		// pass of a layer runs right before its results are merged, to skip the symbols decoded so far. The readers
+		// run concurrently with the maxSymbols left at the start of their passes, the merge makes sure every result
+		// is the one the serial code would have gotten with the maxSymbols left after all the readers before it.
+		struct Pass
+		{
+			const MultiFormatReader& reader;
+			BinaryBitmap& bitmap;
+			bool inverted;
+			std::vector<Barcodes> results = {};
+			std::vector<int> maxSymbols = {}; // the ones the results were computed with, 0 if they were not
+		};
+
+		auto& pool = *threadPool;
+
+		// run the readers of the passes concurrently, except for the ones that use the ThreadPool themselves, those
+		// run when the pass is merged (see mergePass)
+		auto runPasses = [&](std::vector<Pass>& passes) {
+			std::vector<std::pair<int, int>> jobs; // (pass, reader)
+			for (int i = 0; i < Size(passes); ++i) {
+				passes[i].results.resize(passes[i].reader.size());
+				passes[i].maxSymbols.resize(passes[i].reader.size());
+				for (int j = 0; j < passes[i].reader.size(); ++j)
+					if (!passes[i].reader.usesThreads(j))
+						jobs.emplace_back(i, j);
 			}
 
-			// TODO: check if closing after invert would be beneficial
-			for (int invert = 0; invert <= static_cast<int>(opts.tryInvert() && !close); ++invert) {
-				if (invert)
+			// the worker threads check the deadline of the calling thread (see ThreadPool), if it expired, jobs are skipped
+			pool.parallelFor(Size(jobs), [&](int i, int) {
+				auto [pass, reader] = jobs[i];
+				auto& p = passes[pass];
+				if (Deadline::Expired())
+					return;
+				p.results[reader] = p.reader.read(p.bitmap, reader, maxSymbols);
+				p.maxSymbols[reader] = maxSymbols;
+			});
+		};
+
+		// Merge the results of a pass into res the same way MultiFormatReader::read(image, maxSymbols) and the serial
+		// code do, returns false if maxSymbols has been reached. Every reader needs the results for the maxSymbols left
+		// after the ones before it. Those computed with a bigger maxSymbols are truncated if the reader allows that,
+		// otherwise (and for the readers that did not run yet) the reader runs again, on the calling thread.
+		auto mergePass = [&](Pass& p, const ImageView& iv) {
+			std::vector<Barcodes> results;
+			for (int j = 0, left = maxSymbols; j < p.reader.size() && left > 0 && !Deadline::Expired(); ++j) {
+				if (p.maxSymbols[j] != left && !(p.maxSymbols[j] && p.reader.truncatesAtMaxSymbols(j))) {
+					// the bitmaps of all passes of a round are inverted in between
+					if (p.bitmap.inverted() != p.inverted)
+						p.bitmap.invert();
+					p.results[j] = p.reader.read(p.bitmap, j, left);
+				}
+				results.push_back(std::move(p.results[j]));
+				left -= Size(results.back());
+			}
+			return addResults(MultiFormatReader::merge(std::move(results), maxSymbols), iv, p.inverted);
+		};
+
+		// in coarseToFine mode the layers need to be processed one after the other to mask the symbols found so far
+		const int layersPerRound = opts.coarseToFine() ? 1 : Size(layers);
+		for (int first = 0; first < Size(layers) && !Deadline::Expired(); first += layersPerRound) {
+			auto round = std::span(layers).subspan(first, layersPerRound);
+
+			// The bit matrices are computed up front, one after the other, each binarized by all threads in horizontal
+			// bands. That balances the load better than binarizing the (differently sized) layers concurrently.
+			std::vector<std::unique_ptr<BinaryBitmap>> bitmaps;
+			const BinaryBitmap* parent = nullptr; // the previous layer, unless the layers are ordered from coarse to fine
+			for (auto&& iv : round) {
+				auto& bitmap = bitmaps.emplace_back(CreateBitmap(opts, iv, _iv.width() / iv.width(), &matrixPool, &pool, parent));
+				if (opts.coarseToFine())
+					MaskFoundSymbols(*bitmap, res, _iv.width() / iv.width());
+				// invert() and close() only operate on an existing matrix, the linear readers don't need one
+				if (tryInvert || closedReader || opts.hasAnyFormat(BarcodeFormat::AllMatrix))
+					bitmap->getBitMatrix();
+				if (!opts.coarseToFine())
+					parent = bitmap.get();
+			}
+
+			std::vector<Pass> normal, inverted;
+			for (auto& bitmap : bitmaps)
+				normal.push_back({reader, *bitmap, false});
+			runPasses(normal);
+
+			if (tryInvert && !Deadline::Expired()) {
+				for (auto& bitmap : bitmaps) {
 					bitmap->invert();
-				auto rs = (close ? *closedReader : reader).read(*bitmap, maxSymbols);
-				for (auto& r : rs) {
-					if (iv.width() != _iv.width())
-						r.d->position = Scale(r.position(), _iv.width() / iv.width());
-					if (!Contains(res, r)) {
-						r.setReaderOptions(opts);
-						r.d->isInverted = bitmap->inverted();
-						res.push_back(std::move(r));
-						--maxSymbols;
-					}
+					inverted.push_back({reader, *bitmap, true});
 				}
-				if (maxSymbols <= 0)
+				runPasses(inverted);
+			}
+
+			for (int i = 0; i < Size(round); ++i) {
+				const auto& iv = round[i];
+				auto& bitmap = *bitmaps[i];
+				if (!mergePass(normal[i], iv) || (!inverted.empty() && !mergePass(inverted[i], iv)))
 					return res;
+
+				if (closedReader && !Deadline::Expired()) {
+					// if we inverted the image above, we need to undo that first
+					if (bitmap.inverted())
+						bitmap.invert();
+					// only the symbols that could not be decoded before need to be looked at again
+					MaskFoundSymbols(bitmap, res, _iv.width() / iv.width());
+					if (!bitmap.close())
+						continue; // reading the unchanged image again would not find anything new
+					std::vector<Pass> closed = {{*closedReader, bitmap, false}};
+					runPasses(closed);
+					if (!mergePass(closed[0], iv))
+						return res;
+				}
 			}
 		}
+	} else {
+		// the previous layer, unless the layers are ordered from coarse to fine, see HybridBinarizer
+		std::unique_ptr<BinaryBitmap> parent;
+		for (auto&& iv : layers) {
+			if (Deadline::Expired())
+				return res;
+			auto bitmap = CreateBitmap(opts, iv, _iv.width() / iv.width(), &matrixPool, nullptr, parent.get());
+			parent.reset();
+			if (opts.coarseToFine())
+				MaskFoundSymbols(*bitmap, res, _iv.width() / iv.width());
+			for (int close = 0; close <= (closedReader ? 1 : 0); ++close) {
+				if (close) {
+					// if we already inverted the image in the first round, we need to undo that first
+					if (bitmap->inverted())
+						bitmap->invert();
+					// only the symbols that could not be decoded before need to be looked at again
+					MaskFoundSymbols(*bitmap, res, _iv.width() / iv.width());
+					if (!bitmap->close())
+						break; // reading the unchanged image again would not find anything new
+				}
+
+				// TODO: check if closing after invert would be beneficial
+				for (int invert = 0; invert <= static_cast<int>(tryInvert && !close); ++invert) {
+					if (Deadline::Expired())
+						return res;
+					if (invert)
+						bitmap->invert();
+					auto rs = (close ? *closedReader : reader).read(*bitmap, maxSymbols);
+					if (!addResults(std::move(rs), iv, bitmap->inverted()))
+						return res;
+				}
+			}
+			if (!opts.coarseToFine())
+				parent = std::move(bitmap);
+		}
 	}
 
 	if (opts.returnErrors()) {
@@ -318,8 +832,79 @@ Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
 	return res;
 }
 
+Barcode ReadBarcode(const ImageView& _iv, const ReaderOptions& opts)
+{
+	return FirstOrDefault(ReadBarcodes(_iv, ReaderOptions(opts).maxNumberOfSymbols(1)));
+}
+
+Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts)
+{
+	return ReaderSession(opts).read(_iv);
+}
+
+Barcodes ReadBarcodes(const ImageView& _iv, const ReaderOptions& opts, bool& partial)
+{
+	ReaderSession session(opts);
+	auto res = session.read(_iv);
+	partial = session.partial();
+	return res;
+}
+
+std::vector<Barcodes> ReadBarcodesBatch(std::span<const ImageView> images, const ReaderOptions& opts, int threads)
+{
+	if (threads <= 0)
+		threads = std::thread::hardware_concurrency();
+
+	// the parallelism is already exploited on the image level, don't oversubscribe by processing each image in parallel
+	auto sessionOpts = ReaderOptions(opts).maxThreads(1);
+
+	std::vector<Barcodes> res(images.size());
+	ThreadPool pool(ThreadLocalScratchBuffers ? std::clamp(threads, 1, std::max(1, Size(images))) : 1);
+	std::vector<std::optional<ReaderSession>> sessions(pool.size());
+
+	pool.parallelFor(Size(images), [&](int i, int worker) {
+		if (!sessions[worker])
+			sessions[worker].emplace(sessionOpts);
+		res[i] = sessions[worker]->read(images[i]);
+	});
+
+	return res;
+}
+
 #else // ZXING_READERS
 
+struct ReaderSession::Data
+{
+	ReaderOptions opts;
+};
+
+ReaderSession::ReaderSession(const ReaderOptions& options) : d(std::make_unique<Data>(options)) {}
+ReaderSession::~ReaderSession() = default;
+ReaderSession::ReaderSession(ReaderSession&&) noexcept = default;
+ReaderSession& ReaderSession::operator=(ReaderSession&&) noexcept = default;
+
+const ReaderOptions& ReaderSession::options() const noexcept
+{
+	return d->opts;
+}
+
+Barcodes ReaderSession::read(const ImageView&)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
+}
+
+Barcodes ReaderSession::track(const ImageView&, int)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
+}
+
+void ReaderSession::cancel() noexcept {}
+
+bool ReaderSession::partial() const noexcept
+{
+	return false;
+}
+
 Barcode ReadBarcode(const ImageView&, const ReaderOptions&)
 {
 	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
@@ -330,6 +915,16 @@ Barcodes ReadBarcodes(const ImageView&, const ReaderOptions&)
 	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
 }
 
+Barcodes ReadBarcodes(const ImageView&, const ReaderOptions&, bool&)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
+}
+
+std::vector<Barcodes> ReadBarcodesBatch(std::span<const ImageView>, const ReaderOptions&, int)
+{
+	throw std::runtime_error("This build of zxing-cpp does not support reading barcodes.");
+}
+
 #endif // ZXING_READERS
 
 } // ZXing
@@ -9,6 +9,13 @@
 #include "ImageView.h"
 #include "Barcode.h"
 
+#include <memory>
+#include <vector>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
 namespace ZXing {
 
 /**
@@ -23,11 +30,100 @@ Barcode ReadBarcode(const ImageView& image, const ReaderOptions& options = {});
 /**
  * Read barcodes from an ImageView
  *
+ * If ReaderOptions::maxThreads is not 1, a ThreadPool is started and stopped for every call. Use a ReaderSession to keep
+ * the pool (and all other temporary buffers) alive when processing several images.
+ *
  * @param image  view of the image data including layout and format
  * @param options  optional ReaderOptions to parameterize / speed up detection
  * @return List of Barcode found, may be empty
  */
 Barcodes ReadBarcodes(const ImageView& image, const ReaderOptions& options = {});
 
+/**
+ * Read barcodes from an ImageView, see ReadBarcodes() above
+ *
+ * @param image  view of the image data including layout and format
+ * @param options  ReaderOptions to parameterize / speed up detection
+ * @param partial  set to true if the search ran out of time (see ReaderOptions::timeBudget), i.e. the result may be
+ * incomplete
+ * @return List of Barcode found, may be empty
+ */
+Barcodes ReadBarcodes(const ImageView& image, const ReaderOptions& options, bool& partial);
+
+#ifdef __cpp_lib_span
+/**
+ * Read barcodes from a list of ImageViews in parallel
+ *
+ * The images are distributed over a pool of worker threads, each with its own set of readers and scratch buffers (see
+ * ReaderSession). Idle workers steal images from busy ones, so the runtime is balanced even if the time needed per
+ * image varies a lot. ReaderOptions::maxThreads is ignored, each image is processed by a single thread. If reading one of
+ * the images throws an exception, the processing is stopped and the exception is rethrown.
+ *
+ * @param images  views of the image data including layout and format
+ * @param options  optional ReaderOptions to parameterize / speed up detection
+ * @param threads  number of threads to use, <= 0 means one per hardware thread, 1 if ZX_THREAD_LOCAL is not thread_local
+ * @return List of Barcodes found per image, in the same order as the input images
+ */
+std::vector<Barcodes> ReadBarcodesBatch(std::span<const ImageView> images, const ReaderOptions& options = {}, int threads = 0);
+#endif
+
+/**
+ * @brief Stateful alternative to ReadBarcodes() for processing a sequence of images with the same ReaderOptions.
+ *
+ * A ReaderSession creates the internal symbology readers only once and keeps its temporary buffers (luminance image,
+ * downscaled image pyramid, binarized bit matrices) alive between calls to read(). As long as the image size does not
+ * change (e.g. the frames of a camera stream), no buffers need to be reallocated.
+ *
+ * A ReaderSession is not thread-safe, use one instance per thread. The only exception is cancel().
+ */
+class ReaderSession
+{
+	struct Data;
+	std::unique_ptr<Data> d;
+
+public:
+	explicit ReaderSession(const ReaderOptions& options = {});
+	~ReaderSession();
+	ReaderSession(ReaderSession&&) noexcept;
+	ReaderSession& operator=(ReaderSession&&) noexcept;
+
+	const ReaderOptions& options() const noexcept;
+
+	/**
+	 * Read barcodes from an ImageView, see ReadBarcodes()
+	 *
+	 * @param image  view of the image data including layout and format
+	 * @return List of Barcode found, may be empty
+	 */
+	Barcodes read(const ImageView& image);
+
+	/**
+	 * Read barcodes from the next frame of a video stream (tracking mode)
+	 *
+	 * The symbols found in the previous frame are first only searched for in a small window around their previous
+	 * position, restricted to their respective formats. A full search of the frame (see read()) is done for the first
+	 * frame, every fullSearchInterval frames (to pick up new symbols) and whenever one of the previously found symbols
+	 * could not be found again. The windows are clipped to the ReaderOptions::regionsOfInterest (if any).
+	 *
+	 * Each window is searched by the regular detectors, the symbols are not re-sampled based on their previous
+	 * perspective transform. That makes tracking cheaper than a full search only if the symbols cover a small part of
+	 * the image.
+	 *
+	 * @param image  view of the image data including layout and format
+	 * @param fullSearchInterval  maximum number of frames between two full searches
+	 * @return List of Barcode found, may be empty
+	 */
+	Barcodes track(const ImageView& image, int fullSearchInterval = 10);
+
+	/**
+	 * Stop a currently running read() or track() call (from another thread) as soon as possible. The interrupted call
+	 * returns the barcodes found so far and partial() returns true. If no call is running, the next one is stopped.
+	 */
+	void cancel() noexcept;
+
+	/// Returns true if the last read() or track() call ran out of time (see ReaderOptions::timeBudget) or was cancelled.
+	bool partial() const noexcept;
+};
+
 } // ZXing
 
@@ -27,6 +27,13 @@ public:
 	virtual ~Reader() = default;
 
 	virtual BarcodesData read(const BinaryBitmap& image, int maxSymbols) const = 0;
+
+	/// Whether read() processes the image concurrently itself if the image has a ThreadPool (see BinaryBitmap::threads()).
+	virtual bool usesThreads() const { return false; }
+
+	/// Whether the results of read(image, n) are the first n results of read(image, m) for all n < m, i.e. maxSymbols
+	/// only stops the search early and does not change the results found until then.
+	virtual bool truncatesAtMaxSymbols() const { return true; }
 };
 
 } // ZXing
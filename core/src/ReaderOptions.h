@@ -11,9 +11,11 @@
 #include "CharacterSet.h"
 #include "Version.h"
 
+#include <chrono>
 #include <string_view>
 #include <utility>
 #include <memory>
+#include <vector>
 
 namespace ZXing {
 
@@ -28,6 +30,7 @@ enum class Binarizer : unsigned char // needs to be unsigned for the bitfield be
 	GlobalHistogram, ///< T = valley between the 2 largest peaks in the histogram (per line in linear case)
 	FixedThreshold,  ///< T = 127
 	BoolCast,        ///< T = 0, fastest possible
+	Adaptive,        ///< T = mean * (1 + k * (stddev / 128 - 1)) of the neighboring pixels (Sauvola, AdaptiveBinarizer)
 };
 
 /**
@@ -40,6 +43,14 @@ enum class EanAddOnSymbol : unsigned char // see above
 	Require, ///< Require EAN-2/EAN-5 Add-On symbol to be present
 };
 
+/**
+ * @brief Axis aligned rectangle in image (pixel) coordinates, see ReaderOptions::regionsOfInterest().
+ */
+struct Rect
+{
+	int left = 0, top = 0, width = 0, height = 0;
+};
+
 /**
  * @brief Specify how the decoded byte content of a barcode should be transcoded to text.
  *
@@ -104,6 +115,14 @@ public:
 	inline ReaderOptions& setFormats(const BarcodeFormats& v) & { return formats(BarcodeFormats(v)); }
 	inline ReaderOptions&& setFormats(const BarcodeFormats& v) && { return std::move(*this).formats(BarcodeFormats(v)); }
 
+	/// Restrict the search to the given image regions, the default (empty list) means the whole image. Only the
+	/// bounding box of all regions is binarized, the reported positions are in full image coordinates.
+	const std::vector<Rect>& regionsOfInterest() const noexcept;
+	ReaderOptions& regionsOfInterest(std::vector<Rect> v) &;
+	ReaderOptions&& regionsOfInterest(std::vector<Rect> v) &&;
+	inline ReaderOptions& setRegionsOfInterest(std::vector<Rect> v) & { return regionsOfInterest(std::move(v)); }
+	inline ReaderOptions&& setRegionsOfInterest(std::vector<Rect> v) && { return std::move(*this).regionsOfInterest(std::move(v)); }
+
 	/// Spend more time to try to find a barcode; optimize for accuracy instead of not speed (default: true).
 	ZX_PROPERTY(bool, tryHarder, setTryHarder)
 
@@ -116,6 +135,18 @@ public:
 	/// Try detecting code in downscaled images (depending on image size) (default: true).
 	ZX_PROPERTY(bool, tryDownscale, setTryDownscale)
 
+	/// Try detecting linear codes at angles other than multiples of 90 degrees that are too short to be crossed
+	/// completely by a row or column of the image, if nothing was found otherwise (default: false). The columns for
+	/// tryRotate are then sampled from the binarized image like the oblique lines instead of reading the rotated image.
+	/// Slower on images without any linear code.
+	ZX_PROPERTY(bool, tryOblique, setTryOblique)
+
+	/// Start with the smallest downscaled image and hide the matrix codes found there from the detectors when
+	/// processing the higher resolution images (default: false). Faster for large images. The positions of the valid
+	/// symbols found in a downscaled image are not refined, i.e. they are less precise. Only the symbols decoded with an
+	/// error (see returnErrors) are searched for again in the higher resolution images.
+	ZX_PROPERTY(bool, coarseToFine, setCoarseToFine)
+
 #ifdef ZXING_EXPERIMENTAL_API
 	/// Also try detecting code after denoising (currently morphological closing filter for 2D formats only).
 	ZX_PROPERTY(bool, tryDenoise, setTryDenoise)
@@ -124,6 +155,10 @@ public:
 	/// Binarizer to use for grayscale to binary transformation (default: Binarizer::LocalAverage).
 	ZX_PROPERTY(Binarizer, binarizer, setBinarizer)
 
+	/// Side length (in pixels of the input image) of the neighborhood Binarizer::Adaptive computes the threshold of a
+	/// pixel from, 0 means 1/4th of the smaller image dimension (default: 0). Ignored by the other binarizers.
+	ZX_PROPERTY(uint16_t, binarizerWindow, setBinarizerWindow)
+
 	/// Set to true if the input contains nothing but a single perfectly aligned barcode (generated image).
 	ZX_PROPERTY(bool, isPure, setIsPure)
 
@@ -139,6 +174,16 @@ public:
 	/// The maximum number of symbols (barcodes) to detect / look for with ReadBarcodes().
 	ZX_PROPERTY(uint8_t, maxNumberOfSymbols, setMaxNumberOfSymbols)
 
+	/// Maximum number of threads used to process a single image (binarization in horizontal bands, concurrent readers), 0
+	/// means one per hardware thread (default: 1). The results are the same as with a single thread. ReadBarcodes() starts
+	/// a new pool of threads per call, a ReaderSession keeps its pool between calls. Ignored if ZX_THREAD_LOCAL (see
+	/// ZXConfig.h) is not thread_local.
+	ZX_PROPERTY(uint8_t, maxThreads, setMaxThreads)
+
+	/// Stop searching after the given time and return what was found so far, 0 means no limit (default: 0).
+	/// See ReaderSession::partial() or ReadBarcodes(image, options, partial) to find out if the time ran out.
+	ZX_PROPERTY(std::chrono::microseconds, timeBudget, setTimeBudget)
+
 	/// Validate optional checksums where applicable (e.g. Code39, ITF) (default: false).
 	ZX_PROPERTY(bool, validateOptionalChecksum, setValidateOptionalChecksum)
 
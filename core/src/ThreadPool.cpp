@@ -0,0 +1,210 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ThreadPool.h"
+
+#include "Deadline.h"
+#include "ZXAlgorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ZXing {
+
+struct ThreadPool::Data
+{
+	// the remaining index range [begin, end) of one worker
+	struct Chunk
+	{
+		std::mutex mutex;
+		int begin = 0, end = 0;
+	};
+
+	const int size;
+	std::unique_ptr<Chunk[]> chunks;
+	std::vector<std::thread> threads;
+
+	std::mutex jobMutex; // serializes concurrent parallelFor() calls from different threads
+	std::mutex mutex;
+	std::condition_variable startCV, doneCV;
+	const std::function<void(int, int)>* func = nullptr;
+	const Deadline::Scope* deadlines = nullptr; // of the thread calling parallelFor(), checked by all workers
+	int generation = 0;
+	int running = 0; // number of background workers still busy with the current job
+	bool stop = false;
+	std::atomic<bool> failed = false;
+	std::exception_ptr exception;
+
+	explicit Data(int size) : size(size), chunks(new Chunk[size]) {}
+
+	bool next(int worker, int& index);
+	void work(int worker);
+	void threadMain(int worker);
+};
+
+// the pool the current thread is working for (used to detect nested parallelFor calls). This is state, not a scratch
+// buffer, so it has to be thread_local regardless of ZX_THREAD_LOCAL.
+static thread_local const void* currentPool = nullptr;
+static thread_local int currentWorker = 0;
+
+bool ThreadPool::Data::next(int worker, int& index)
+{
+	auto& own = chunks[worker];
+	{
+		std::lock_guard lock(own.mutex);
+		if (own.begin < own.end) {
+			index = own.begin++;
+			return true;
+		}
+	}
+
+	// steal the upper half of the remaining range of some other worker
+	for (int i = 1; i < size; ++i) {
+		auto& victim = chunks[(worker + i) % size];
+		int begin, end;
+		{
+			std::lock_guard lock(victim.mutex);
+			int n = victim.end - victim.begin;
+			if (n <= 0)
+				continue;
+			begin = victim.end - (n + 1) / 2;
+			end = std::exchange(victim.end, begin);
+		}
+		std::lock_guard lock(own.mutex);
+		index = begin;
+		own.begin = begin + 1;
+		own.end = end;
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::Data::work(int worker)
+{
+	auto prevPool = std::exchange(currentPool, this);
+	auto prevWorker = std::exchange(currentWorker, worker);
+
+	int index;
+	while (!failed && next(worker, index)) {
+		try {
+			(*func)(index, worker);
+		} catch (...) {
+			std::lock_guard lock(mutex);
+			if (!exception)
+				exception = std::current_exception();
+			failed = true;
+		}
+	}
+
+	currentPool = prevPool;
+	currentWorker = prevWorker;
+}
+
+void ThreadPool::Data::threadMain(int worker)
+{
+	int seen = 0;
+	while (true) {
+		{
+			std::unique_lock lock(mutex);
+			startCV.wait(lock, [&] { return stop || generation != seen; });
+			if (stop)
+				return;
+			seen = generation;
+		}
+
+		{
+			Deadline::Inherit inherit(deadlines);
+			work(worker);
+		}
+
+		std::lock_guard lock(mutex);
+		if (--running == 0)
+			doneCV.notify_one();
+	}
+}
+
+ThreadPool::ThreadPool(int threads)
+{
+	if (threads <= 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+
+	d = std::make_unique<Data>(threads);
+	d->threads.reserve(threads - 1);
+	for (int i = 1; i < threads; ++i)
+		d->threads.emplace_back(&Data::threadMain, d.get(), i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(d->mutex);
+		d->stop = true;
+	}
+	d->startCV.notify_all();
+	for (auto& t : d->threads)
+		t.join();
+}
+
+int ThreadPool::size() const noexcept
+{
+	return d->size;
+}
+
+bool ThreadPool::concurrent() const noexcept
+{
+	return d->size > 1 && currentPool != d.get();
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int index, int worker)>& func)
+{
+	if (count <= 0)
+		return;
+
+	if (d->size == 1 || count == 1 || currentPool == d.get()) {
+		int worker = currentPool == d.get() ? currentWorker : 0;
+		for (int i = 0; i < count; ++i)
+			func(i, worker);
+		return;
+	}
+
+	std::lock_guard jobLock(d->jobMutex);
+
+	for (int w = 0; w < d->size; ++w) {
+		std::lock_guard lock(d->chunks[w].mutex);
+		d->chunks[w].begin = narrow_cast<int>(int64_t(count) * w / d->size);
+		d->chunks[w].end = narrow_cast<int>(int64_t(count) * (w + 1) / d->size);
+	}
+
+	{
+		std::lock_guard lock(d->mutex);
+		d->func = &func;
+		d->deadlines = Deadline::CurrentScope();
+		d->failed = false;
+		d->exception = nullptr;
+		d->running = d->size - 1;
+		++d->generation;
+	}
+	d->startCV.notify_all();
+
+	d->work(0);
+
+	std::unique_lock lock(d->mutex);
+	d->doneCV.wait(lock, [this] { return d->running == 0; });
+	d->func = nullptr;
+	d->deadlines = nullptr;
+
+	if (d->exception)
+		std::rethrow_exception(d->exception);
+}
+
+} // ZXing
@@ -0,0 +1,51 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+namespace ZXing {
+
+/**
+ * @brief Work-stealing thread pool to process a range of independent tasks in parallel.
+ *
+ * The index range of each parallelFor() call is split into one contiguous chunk per worker. A worker that runs out
+ * of work steals the upper half of the remaining chunk of another worker. The thread calling parallelFor()
+ * participates as worker 0, so a pool of size 1 does not start any background thread at all.
+ *
+ * A nested parallelFor() call from within a task of the same pool is executed serially on the calling worker.
+ */
+class ThreadPool
+{
+	struct Data;
+	std::unique_ptr<Data> d;
+
+public:
+	/// @param threads  total number of workers including the calling thread, <= 0 means hardware concurrency
+	explicit ThreadPool(int threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// Number of workers including the calling thread.
+	int size() const noexcept;
+
+	/// Whether a parallelFor() call from the current thread runs concurrently, i.e. it is not nested (see above).
+	bool concurrent() const noexcept;
+
+	/**
+	 * Call func(index, worker) for each index in [0, count) and block until all calls have returned.
+	 *
+	 * The worker argument is in the range [0, size()) and can be used to access per-worker state. The first exception
+	 * thrown by func stops the processing of the remaining indices and is rethrown to the caller. The deadlines of the
+	 * calling thread (see Deadline::Scope) are installed for the background workers while they call func.
+	 */
+	void parallelFor(int count, const std::function<void(int index, int worker)>& func);
+};
+
+} // ZXing
@@ -17,7 +17,9 @@ class ThresholdBinarizer : public BinaryBitmap
 	const uint8_t _threshold = 0;
 
 public:
-	ThresholdBinarizer(const ImageView& buffer, uint8_t threshold = 128) : BinaryBitmap(buffer), _threshold(threshold) {}
+	ThresholdBinarizer(const ImageView& buffer, uint8_t threshold = 128, BitMatrixPool* pool = nullptr, ThreadPool* threads = nullptr)
+		: BinaryBitmap(buffer, pool, threads), _threshold(threshold)
+	{}
 
 	bool getPatternRow(int row, int rotation, PatternRow& res) const override
 	{
@@ -51,7 +53,7 @@ public:
 
 	std::shared_ptr<const BitMatrix> getBlackMatrix() const override
 	{
-		return std::make_shared<const BitMatrix>(binarize(_threshold));
+		return binarize(_threshold);
 	}
 };
 
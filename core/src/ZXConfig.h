@@ -8,6 +8,7 @@
 // Thread local or static memory may be used to reduce the number of (re-)allocations of temporary variables
 // in e.g. the HistogramBinarizer. The default is thread_local, which is the best option for performance and safety in most cases. If
 // your platform doesn't support thread_local, you can switch to static, but be aware that this makes the code not thread safe.
+// In that case ReaderOptions::maxThreads and ReadBarcodesBatch() do not start any threads of their own either.
 // For Windows in Visual Studio 2019 on Intel 64-bit using thread_local causes a dependency to VCRUNTIME140_1.dll, so you need 2019
 // runtime DLLs instead of only 2015 version.
 #define ZX_THREAD_LOCAL thread_local // '' (nothing), 'thread_local' or 'static'
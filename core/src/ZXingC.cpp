@@ -12,6 +12,7 @@
 #include "Version.h"
 
 #include <bit>
+#include <chrono>
 #include <cstdlib>
 #include <exception>
 #include <string>
@@ -293,17 +294,30 @@ ZX_PROPERTY(bool, tryHarder, TryHarder)
 ZX_PROPERTY(bool, tryRotate, TryRotate)
 ZX_PROPERTY(bool, tryInvert, TryInvert)
 ZX_PROPERTY(bool, tryDownscale, TryDownscale)
+ZX_PROPERTY(bool, tryOblique, TryOblique)
 #ifdef ZXING_EXPERIMENTAL_API
 	ZX_PROPERTY(bool, tryDenoise, TryDenoise)
 #endif
 ZX_PROPERTY(bool, isPure, IsPure)
 ZX_PROPERTY(bool, validateOptionalChecksum, ValidateOptionalChecksum)
 ZX_PROPERTY(bool, returnErrors, ReturnErrors)
+ZX_PROPERTY(int, binarizerWindow, BinarizerWindow)
 ZX_PROPERTY(int, minLineCount, MinLineCount)
 ZX_PROPERTY(int, maxNumberOfSymbols, MaxNumberOfSymbols)
+ZX_PROPERTY(int, maxThreads, MaxThreads)
 
 #undef ZX_PROPERTY
 
+void ZXing_ReaderOptions_setTimeBudget(ZXing_ReaderOptions* opts, int milliseconds)
+{
+	opts->timeBudget(std::chrono::milliseconds(milliseconds));
+}
+
+int ZXing_ReaderOptions_getTimeBudget(const ZXing_ReaderOptions* opts)
+{
+	return narrow_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(opts->timeBudget()).count());
+}
+
 void ZXing_ReaderOptions_setFormats(ZXing_ReaderOptions* opts, const ZXing_BarcodeFormat* formats, int count)
 {
 	if (!formats || !count)
@@ -344,6 +358,19 @@ ZXing_Barcodes* ZXing_ReadBarcodes(const ZXing_ImageView* iv, const ZXing_Reader
 	ZX_CATCH(NULL);
 }
 
+ZXing_Barcodes* ZXing_ReadBarcodesTimed(const ZXing_ImageView* iv, const ZXing_ReaderOptions* opts, bool* partial)
+{
+	ZX_CHECK(iv, "ImageView param is NULL")
+	try {
+		bool isPartial = false;
+		auto res = ReadBarcodes(*iv, opts ? *opts : ReaderOptions{}, isPartial);
+		if (partial)
+			*partial = isPartial;
+		return res.empty() ? &emptyBarcodes : new Barcodes(std::move(res));
+	}
+	ZX_CATCH(NULL);
+}
+
 
 /*
  * MARK: - CreateBarcode.h
@@ -174,6 +174,7 @@ typedef enum
 	ZXing_Binarizer_GlobalHistogram,
 	ZXing_Binarizer_FixedThreshold,
 	ZXing_Binarizer_BoolCast,
+	ZXing_Binarizer_Adaptive,
 } ZXing_Binarizer;
 
 typedef enum
@@ -200,6 +201,7 @@ void ZXing_ReaderOptions_setTryHarder(ZXing_ReaderOptions* opts, bool tryHarder)
 void ZXing_ReaderOptions_setTryRotate(ZXing_ReaderOptions* opts, bool tryRotate);
 void ZXing_ReaderOptions_setTryInvert(ZXing_ReaderOptions* opts, bool tryInvert);
 void ZXing_ReaderOptions_setTryDownscale(ZXing_ReaderOptions* opts, bool tryDownscale);
+void ZXing_ReaderOptions_setTryOblique(ZXing_ReaderOptions* opts, bool tryOblique);
 #ifdef ZXING_EXPERIMENTAL_API
 	void ZXing_ReaderOptions_setTryDenoise(ZXing_ReaderOptions* opts, bool tryDenoise);
 #endif
@@ -208,15 +210,19 @@ void ZXing_ReaderOptions_setValidateOptionalChecksum(ZXing_ReaderOptions* opts,
 void ZXing_ReaderOptions_setReturnErrors(ZXing_ReaderOptions* opts, bool returnErrors);
 void ZXing_ReaderOptions_setFormats(ZXing_ReaderOptions* opts, const ZXing_BarcodeFormat* formats, int count);
 void ZXing_ReaderOptions_setBinarizer(ZXing_ReaderOptions* opts, ZXing_Binarizer binarizer);
+void ZXing_ReaderOptions_setBinarizerWindow(ZXing_ReaderOptions* opts, int window);
 void ZXing_ReaderOptions_setEanAddOnSymbol(ZXing_ReaderOptions* opts, ZXing_EanAddOnSymbol eanAddOnSymbol);
 void ZXing_ReaderOptions_setTextMode(ZXing_ReaderOptions* opts, ZXing_TextMode textMode);
 void ZXing_ReaderOptions_setMinLineCount(ZXing_ReaderOptions* opts, int n);
 void ZXing_ReaderOptions_setMaxNumberOfSymbols(ZXing_ReaderOptions* opts, int n);
+void ZXing_ReaderOptions_setMaxThreads(ZXing_ReaderOptions* opts, int n);
+void ZXing_ReaderOptions_setTimeBudget(ZXing_ReaderOptions* opts, int milliseconds);
 
 bool ZXing_ReaderOptions_getTryHarder(const ZXing_ReaderOptions* opts);
 bool ZXing_ReaderOptions_getTryRotate(const ZXing_ReaderOptions* opts);
 bool ZXing_ReaderOptions_getTryInvert(const ZXing_ReaderOptions* opts);
 bool ZXing_ReaderOptions_getTryDownscale(const ZXing_ReaderOptions* opts);
+bool ZXing_ReaderOptions_getTryOblique(const ZXing_ReaderOptions* opts);
 #ifdef ZXING_EXPERIMENTAL_API
 	bool ZXing_ReaderOptions_getTryDenoise(const ZXing_ReaderOptions* opts);
 #endif
@@ -225,10 +231,13 @@ bool ZXing_ReaderOptions_getValidateOptionalChecksum(const ZXing_ReaderOptions*
 bool ZXing_ReaderOptions_getReturnErrors(const ZXing_ReaderOptions* opts);
 ZXing_BarcodeFormat* ZXing_ReaderOptions_getFormats(const ZXing_ReaderOptions* opts, int* outCount);
 ZXing_Binarizer ZXing_ReaderOptions_getBinarizer(const ZXing_ReaderOptions* opts);
+int ZXing_ReaderOptions_getBinarizerWindow(const ZXing_ReaderOptions* opts);
 ZXing_EanAddOnSymbol ZXing_ReaderOptions_getEanAddOnSymbol(const ZXing_ReaderOptions* opts);
 ZXing_TextMode ZXing_ReaderOptions_getTextMode(const ZXing_ReaderOptions* opts);
 int ZXing_ReaderOptions_getMinLineCount(const ZXing_ReaderOptions* opts);
 int ZXing_ReaderOptions_getMaxNumberOfSymbols(const ZXing_ReaderOptions* opts);
+int ZXing_ReaderOptions_getMaxThreads(const ZXing_ReaderOptions* opts);
+int ZXing_ReaderOptions_getTimeBudget(const ZXing_ReaderOptions* opts);
 
 /*
  * MARK: - ReadBarcode.h
@@ -241,6 +250,12 @@ int ZXing_ReaderOptions_getMaxNumberOfSymbols(const ZXing_ReaderOptions* opts);
  */
 ZXing_Barcodes* ZXing_ReadBarcodes(const ZXing_ImageView* iv, const ZXing_ReaderOptions* opts);
 
+/**
+ * Same as ZXing_ReadBarcodes() but partial (if not NULL) is set to true if the search ran out of time, see
+ * ZXing_ReaderOptions_setTimeBudget(), i.e. the result may be incomplete.
+ */
+ZXing_Barcodes* ZXing_ReadBarcodesTimed(const ZXing_ImageView* iv, const ZXing_ReaderOptions* opts, bool* partial);
+
 
 /*
  * MARK: - CreateBarcode.h
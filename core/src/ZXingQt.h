@@ -63,7 +63,7 @@ enum class BarcodeFormat : unsigned int
 
 enum class ContentType { Text, Binary, Mixed, GS1, ISO15434, UnknownECI };
 enum class TextMode { Plain, ECI, HRI, Escaped, Hex, HexECI };
-enum class Binarizer { LocalAverage, GlobalHistogram, FixedThreshold, BoolCast };
+enum class Binarizer { LocalAverage, GlobalHistogram, FixedThreshold, BoolCast, Adaptive };
 
 Q_ENUM_NS(BarcodeFormat)
 Q_ENUM_NS(ContentType)
@@ -18,6 +18,7 @@
 #include "Pattern.h"
 #include "ReedSolomon.h"
 #include "ZXAlgorithms.h"
+#include "ZXConfig.h"
 
 #include <algorithm>
 #include <bit>
@@ -193,7 +194,7 @@ static std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image,
 	int skip = tryHarder ? 1 : std::clamp(image.height() / 2 / 100, 1, 5);
 	int margin = tryHarder ? 5 : image.height() / 4;
 
-	PatternRow row;
+	ZX_THREAD_LOCAL PatternRow row; // reused between calls to save the (re-)allocations
 
 	for (int y = margin; y < image.height() - margin; y += skip)
 	{
@@ -16,6 +16,8 @@ public:
 	using ZXing::Reader::Reader;
 
 	BarcodesData read(const BinaryBitmap& image, int maxSymbols) const override;
+	// Detect() stops after maxSymbols candidates, some of which might not decode
+	bool truncatesAtMaxSymbols() const override { return false; }
 };
 
 } // namespace ZXing::Aztec
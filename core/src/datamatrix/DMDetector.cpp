@@ -10,6 +10,7 @@
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
 #include "Matrix.h"
+#include "Deadline.h"
 #include "DetectorResult.h"
 #include "DMVersion.h"
 #include "GridSampler.h"
@@ -1136,6 +1137,9 @@ static DetectorResults DetectNew(const BitMatrix& image, bool tryHarder, bool tr
 		history.clear();
 
 		for (int i = 1;; ++i) {
+			if (Deadline::Expired())
+				co_return;
+
 			EdgeTracer tracer(image, startPos, dir);
 			tracer.p += i / 2 * minSymbolSize * (i & 1 ? -1 : 1) * tracer.right();
 			if (tryHarder)
@@ -1205,7 +1209,7 @@ DetectorResults Detect(const BitMatrix& image, bool tryHarder, bool tryRotate, b
 			found = true;
 			co_yield std::move(r);
 		}
-		if (!found && tryHarder) {
+		if (!found && tryHarder && !Deadline::Expired()) {
 			if (auto r = DetectOld(image); r.isValid())
 				co_yield std::move(r);
 		}
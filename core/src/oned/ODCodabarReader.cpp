@@ -40,7 +40,8 @@ constexpr float QUIET_ZONE_SCALE = 0.5f;
 // some codabar generator allow the codabar string to be closed by every
 // character. This will cause lots of false positives!
 
-bool IsLeftGuard(const PatternView& view, int spaceInPixel)
+template <typename View>
+bool IsLeftGuard(const View& view, int spaceInPixel)
 {
 #if 0
 	return spaceInPixel > view.sum() * QUIET_ZONE_SCALE &&
@@ -54,7 +55,14 @@ bool IsLeftGuard(const PatternView& view, int spaceInPixel)
 #endif
 }
 
-BarcodeData CodabarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
+double CodabarReader::guardQuietZoneRatio() const
+{
+	// IsLeftGuard requires spaceInPixel > 4 * view[0]
+	return 4;
+}
+
+template <typename View>
+BarcodeData CodabarReader::decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop and checksum characters)
 	// absolute minimum would be 2 (meaning 0 'content'). everything below 4 produces too many false
@@ -62,7 +70,7 @@ BarcodeData CodabarReader::decodePattern(int rowNumber, PatternView& next, std::
 	const int minCharCount = 4;
 	auto isStartOrStopSymbol = [](char c) { return 'A' <= c && c <= 'D'; };
 
-	next = FindLeftGuard<CHAR_LEN>(next, minCharCount * CHAR_LEN, IsLeftGuard);
+	next = FindLeftGuard<CHAR_LEN>(next, minCharCount * CHAR_LEN, IsLeftGuard<View>);
 	if (!next.isValid())
 		return {};
 
@@ -99,4 +107,14 @@ BarcodeData CodabarReader::decodePattern(int rowNumber, PatternView& next, std::
 	return LinearBarcode(BarcodeFormat::Codabar, txt, rowNumber, xStart, xStop, symbologyIdentifier);
 }
 
+BarcodeData CodabarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData CodabarReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
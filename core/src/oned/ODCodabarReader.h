@@ -16,6 +16,12 @@ public:
 	using RowReader::RowReader;
 
 	BarcodeData decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	BarcodeData decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	double guardQuietZoneRatio() const override;
+
+private:
+	template <typename View>
+	BarcodeData decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>& state) const;
 };
 
 } // namespace ZXing::OneD
@@ -166,10 +166,16 @@ public:
 constexpr auto START_PATTERN_PREFIX = FixedPattern<3, 4>{2, 1, 1};
 constexpr float QUIET_ZONE = 5;	// quiet zone spec is 10 modules, real world examples ignore that, see #138
 
-BarcodeData Code128Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
+double Code128Reader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio(START_PATTERN_PREFIX, QUIET_ZONE);
+}
+
+template <typename View>
+BarcodeData Code128Reader::decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>&) const
 {
 	int minCharCount = 4; // start + payload + checksum + stop
-	auto decodePattern = [](const PatternView& view, bool start = false) {
+	auto decodePattern = [](const View& view, bool start = false) {
 		// This is basically the reference algorithm from the specification
 		int code = IndexOf(E2E_PATTERNS, ToInt(NormalizedE2EPattern<CHAR_LEN, CHAR_MODS>(view)));
 		if (code == -1 && !start) // if the reference algo fails, give the original upstream version a try (required to decode a few samples)
@@ -233,4 +239,14 @@ BarcodeData Code128Reader::decodePattern(int rowNumber, PatternView& next, std::
 				   JsonProp(BarcodeExtra::ReaderInit, raw2txt.readerInit()));
 }
 
+BarcodeData Code128Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData Code128Reader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
@@ -116,19 +116,25 @@ static bool IsPZN(std::string_view str)
 	return checksum == str.back() - '0';
 }
 
-BarcodeData Code39Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
+// provide the indices with the narrow bars/spaces which have to be equally wide
+constexpr auto START_PATTERN = FixedSparsePattern<CHAR_LEN, 6>{0, 2, 3, 5, 7, 8};
+// the spec requires a quiet zone of 10x narrow bar width, so with a 1:3 narrow:wide ratio
+// and 3w+6n, a single character is 15x wide, so the below scale would need to be 2/3.
+// This value used to be 1/2 but real-world feedback suggests 1/3 is preferable.
+constexpr float QUIET_ZONE_SCALE = 1.f/3;
+
+double Code39Reader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio(START_PATTERN, QUIET_ZONE_SCALE * 12);
+}
+
+template <typename View>
+BarcodeData Code39Reader::decodeView(int rowNumber, View& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop and checksum characters)
 	int minCharCount = _opts.validateOptionalChecksum() ? 4 : 3;
 	auto isStartOrStopSymbol = [](char c) { return c == '*'; };
 
-	// provide the indices with the narrow bars/spaces which have to be equally wide
-	constexpr auto START_PATTERN = FixedSparsePattern<CHAR_LEN, 6>{0, 2, 3, 5, 7, 8};
-	// the spec requires a quiet zone of 10x narrow bar width, so with a 1:3 narrow:wide ratio
-	// and 3w+6n, a single character is 15x wide, so the below scale would need to be 2/3.
-	// This value used to be 1/2 but real-world feedback suggests 1/3 is preferable.
-	constexpr float QUIET_ZONE_SCALE = 1.f/3;
-
 	next = FindLeftGuard(next, minCharCount * CHAR_LEN, START_PATTERN, QUIET_ZONE_SCALE * 12);
 	if (!next.isValid())
 		return {};
@@ -210,4 +216,14 @@ BarcodeData Code39Reader::decodePattern(int rowNumber, PatternView& next, std::u
 	return LinearBarcode(format, std::move(txt), rowNumber, xStart, xStop, symbologyIdentifier, error);
 }
 
+BarcodeData Code39Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData Code39Reader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
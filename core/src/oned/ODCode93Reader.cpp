@@ -46,23 +46,32 @@ std::string DecodeCode39AndCode93FullASCII(std::string encoded, const char ctrl[
 // quiet zone is half the width of a character symbol
 constexpr float QUIET_ZONE_SCALE = 0.5f;
 
-static bool IsStartGuard(const PatternView& window, int spaceInPixel)
+constexpr auto START_PATTERN_PREFIX = FixedPattern<4, 4>{1, 1, 1, 1};
+
+template <typename View>
+static bool IsStartGuard(const View& window, int spaceInPixel)
 {
 	// The complete start pattern is FixedPattern<CHAR_LEN, CHAR_MODS>{1, 1, 1, 1, 4, 1}.
 	// Use only the first 4 elements which results in more than a 2x speedup. This is counter-intuitive since we save at
 	// most 1/3rd of the loop iterations in FindPattern. The reason might be a successful vectorization with the limited
 	// pattern size that is missed otherwise. We check for the remaining 2 slots for plausibility of the 4:1 ratio.
-	return IsPattern(window, FixedPattern<4, 4>{1, 1, 1, 1}, spaceInPixel, QUIET_ZONE_SCALE * 12) &&
+	return IsPattern(window, START_PATTERN_PREFIX, spaceInPixel, QUIET_ZONE_SCALE * 12) &&
 		   window[4] > 3 * window[5] - 2 &&
 		   ToInt(NormalizedE2EPattern<CHAR_LEN, CHAR_MODS>(window)) == ASTERISK_ENCODING;
 }
 
-BarcodeData Code93Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
+double Code93Reader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio(START_PATTERN_PREFIX, QUIET_ZONE_SCALE * 12);
+}
+
+template <typename View>
+BarcodeData Code93Reader::decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>&) const
 {
 	// minimal number of characters that must be present (including start, stop, checksum and 1 payload characters)
 	int minCharCount = 5;
 
-	next = FindLeftGuard<CHAR_LEN>(next, minCharCount * CHAR_LEN, IsStartGuard);
+	next = FindLeftGuard<CHAR_LEN>(next, minCharCount * CHAR_LEN, IsStartGuard<View>);
 	if (!next.isValid())
 		return {};
 
@@ -109,4 +118,14 @@ BarcodeData Code93Reader::decodePattern(int rowNumber, PatternView& next, std::u
 	return LinearBarcode(BarcodeFormat::Code93, txt, rowNumber, xStart, xStop, symbologyIdentifier, error);
 }
 
+BarcodeData Code93Reader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData Code93Reader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
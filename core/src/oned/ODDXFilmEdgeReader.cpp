@@ -34,8 +34,8 @@ constexpr auto CLOCK_PATTERN_NO_FN = FixedPattern<17, CLOCK_LENGTH_NO_FN>{5, 1,
 constexpr auto DATA_START_PATTERN = FixedPattern<5, 5>{1, 1, 1, 1, 1};
 constexpr auto DATA_STOP_PATTERN = FixedPattern<3, 3>{1, 1, 1};
 
-template <int N, int SUM>
-bool IsPattern(PatternView& view, const FixedPattern<N, SUM>& pattern, float minQuietZone)
+template <int N, int SUM, typename View>
+bool IsPattern(View& view, const FixedPattern<N, SUM>& pattern, float minQuietZone)
 {
 	view = view.subView(0, N);
 	return view.isValid() && IsPattern(view, pattern, view.spaceInFront(), minQuietZone);
@@ -86,7 +86,8 @@ struct DXFEState : public RowReader::DecodingState
 	}
 };
 
-std::optional<Clock> CheckForClock(int rowNumber, PatternView& view)
+template <typename View>
+std::optional<Clock> CheckForClock(int rowNumber, View& view)
 {
 	Clock clock;
 
@@ -106,7 +107,8 @@ std::optional<Clock> CheckForClock(int rowNumber, PatternView& view)
 
 } // namespace
 
-BarcodeData DXFilmEdgeReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+template <typename View>
+BarcodeData DXFilmEdgeReader::decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>& state) const
 {
 	if (!state) {
 		state = std::make_unique<DXFEState>();
@@ -120,7 +122,7 @@ BarcodeData DXFilmEdgeReader::decodePattern(int rowNumber, PatternView& next, st
 		return {};
 
 	// Look for a pattern that is part of both the clock as well as the data track (omitting the first bar)
-	constexpr auto Is4x1 = [](const PatternView& view, int spaceInPixel) {
+	constexpr auto Is4x1 = [](const View& view, int spaceInPixel) {
 #if 0
 		// Find min/max of 4 consecutive bars/spaces and make sure they are close together.
 		auto a = view[1], b = view[2], c = view[3], d = view[4];
@@ -243,4 +245,14 @@ BarcodeData DXFilmEdgeReader::decodePattern(int rowNumber, PatternView& next, st
 	return LinearBarcode(BarcodeFormat::DXFilmEdge, txt, rowNumber, xStart, xStop, si);
 }
 
+BarcodeData DXFilmEdgeReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData DXFilmEdgeReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
@@ -20,7 +20,13 @@ class DXFilmEdgeReader : public RowReader
 public:
 	using RowReader::RowReader;
 
-	BarcodeData decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const override;
+	BarcodeData decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	BarcodeData decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const override;
+	bool usesDecodingState() const override { return true; }
+
+private:
+	template <typename View>
+	BarcodeData decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>& state) const;
 };
 
 } // namespace ZXing::OneD
@@ -67,8 +67,8 @@ int GetValue(ArrayView<int> widths, int maxWidth, bool noNarrow)
 
 using Array4F = std::array<float, 4>;
 
-bool ReadDataCharacterRaw(const PatternView& view, int numModules, bool reversed, Array4I& oddPattern,
-						  Array4I& evnPattern)
+template <typename View>
+bool ReadDataCharacterRaw(const View& view, int numModules, bool reversed, Array4I& oddPattern, Array4I& evnPattern)
 {
 #if 1
 	auto pattern = NormalizedPatternFromE2E<8>(view, numModules, reversed);
@@ -82,7 +82,7 @@ bool ReadDataCharacterRaw(const PatternView& view, int numModules, bool reversed
 	OddEven<Array4F> rem;
 
 	float moduleSize = static_cast<float>(view.sum(8)) / numModules;
-	auto* iter = view.data() + reversed * 7;
+	auto iter = view.data() + reversed * 7;
 	int inc = reversed ? -1 : 1;
 
 	for (int i = 0; i < 8; ++i, iter += inc) {
@@ -148,6 +148,9 @@ bool ReadDataCharacterRaw(const PatternView& view, int numModules, bool reversed
 #endif
 }
 
+template bool ReadDataCharacterRaw(const PatternView&, int, bool, Array4I&, Array4I&);
+template bool ReadDataCharacterRaw(const ReversedPatternView&, int, bool, Array4I&, Array4I&);
+
 static bool IsStacked(const Pair& first, const Pair& last)
 {
 	// check if we see two halfes that are far away from each other in y or overlapping in x
@@ -50,22 +50,26 @@ inline bool IsFinder(int a, int b, int c, int d, int e)
 	return x;
 };
 
-inline PatternView Finder(const PatternView& view)
+template <typename View>
+View Finder(const View& view)
 {
 	return view.subView(8, 5);
 }
 
-inline PatternView LeftChar(const PatternView& view)
+template <typename View>
+View LeftChar(const View& view)
 {
 	return view.subView(0, 8);
 }
 
-inline PatternView RightChar(const PatternView& view)
+template <typename View>
+View RightChar(const View& view)
 {
 	return view.subView(13, 8);
 }
 
-inline float ModSizeFinder(const PatternView& view)
+template <typename View>
+float ModSizeFinder(const View& view)
 {
 	return Finder(view).sum() / 15.f;
 }
@@ -76,7 +80,8 @@ inline bool IsGuard(int a, int b)
 	return a > b * 3 / 4 - 2 && a < b * 5 / 4 + 2;
 }
 
-inline bool IsCharacter(const PatternView& view, int modules, float modSizeRef)
+template <typename View>
+bool IsCharacter(const View& view, int modules, float modSizeRef)
 {
 	float err = std::abs(float(view.sum()) / modules / modSizeRef - 1);
 	return err < 0.1f;
@@ -113,8 +118,8 @@ struct PairHash
 constexpr int FULL_PAIR_SIZE = 8 + 5 + 8;
 constexpr int HALF_PAIR_SIZE = 8 + 5 + 2; // half has to be followed by a guard pattern
 
-template<size_t E2E_LEN, size_t N>
-int ParseFinderPattern(const PatternView& view, bool reversed, const std::array<Pattern<E2E_LEN>, N>& e2ePatterns)
+template<size_t E2E_LEN, size_t N, typename View>
+int ParseFinderPattern(const View& view, bool reversed, const std::array<Pattern<E2E_LEN>, N>& e2ePatterns)
 {
 	static_assert(E2E_LEN == 3);
 	const auto e2e = NormalizedE2EPattern<5, E2E_LEN>(view, 15, reversed);
@@ -146,8 +151,8 @@ using Array4I = std::array<int, 4>;
 // for DataBar:         LEN=8, mods=15/16
 // for DataBarExpanded: LEN=8, mods=17
 // for DataBarLimited:  LEN=14, mods=26/18
-template <int LEN>
-std::array<int, LEN> NormalizedPatternFromE2E(const PatternView& view, int mods, bool reversed = false)
+template <int LEN, typename View>
+std::array<int, LEN> NormalizedPatternFromE2E(const View& view, int mods, bool reversed = false)
 {
 	// To disambiguate the edge-to-edge measurements, it is defined that either the odd or the even-numbered
 	// elements contain at least 1 element that is 1 module wide. (Note: even-numbered elements - 2nd, 4th, 6th, etc., have odd
@@ -194,7 +199,9 @@ std::array<int, LEN> NormalizedPatternFromE2E(const PatternView& view, int mods,
 	return widths;
 }
 
-bool ReadDataCharacterRaw(const PatternView& view, int numModules, bool reversed, Array4I& oddPattern,
+// View is either a PatternView or a ReversedPatternView
+template <typename View>
+bool ReadDataCharacterRaw(const View& view, int numModules, bool reversed, Array4I& oddPattern,
 						  Array4I& evnPattern);
 
 int GetValue(ArrayView<int> widths, int maxWidth, bool noNarrow);
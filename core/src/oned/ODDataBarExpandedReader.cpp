@@ -27,24 +27,28 @@ static bool IsFinderPattern(int a, int b, int c, int d, int e)
 	return IsFinder(a, b, c, d, e) && (c > 3 * e);
 };
 
-static bool IsCharacterPair(const PatternView& v)
+template <typename View>
+static bool IsCharacterPair(const View& v)
 {
 	float modSizeRef = ModSizeFinder(v);
 	return IsCharacter(LeftChar(v), 17, modSizeRef) &&
 		   (v.size() == HALF_PAIR_SIZE || IsCharacter(RightChar(v), 17, modSizeRef));
 }
 
-static bool IsL2RPair(const PatternView& v)
+template <typename View>
+static bool IsL2RPair(const View& v)
 {
 	return IsFinderPattern(v[8], v[9], v[10], v[11], v[12]) && IsCharacterPair(v);
 }
 
-static bool IsR2LPair(const PatternView& v)
+template <typename View>
+static bool IsR2LPair(const View& v)
 {
 	return IsFinderPattern(v[12], v[11], v[10], v[9], v[8]) && IsCharacterPair(v);
 }
 
-static Character ReadDataCharacter(const PatternView& view, int finder, bool reversed)
+template <typename View>
+static Character ReadDataCharacter(const View& view, int finder, bool reversed)
 {
 	constexpr int SYMBOL_WIDEST[]     = {7, 5, 4, 3, 1};
 	constexpr int EVEN_TOTAL_SUBSET[] = {4, 20, 52, 104, 204};
@@ -135,7 +139,8 @@ static const std::array<std::vector<int>, 10> FINDER_PATTERN_SEQUENCES = {{
 
 static const std::array<int, 7> VALID_HALF_PAIRS = {{-FINDER_A, FINDER_B, -FINDER_D, FINDER_C, -FINDER_F, FINDER_F, FINDER_E}};
 
-static int ParseFinderPattern(const PatternView& view, Direction dir)
+template <typename View>
+static int ParseFinderPattern(const View& view, Direction dir)
 {
 	static constexpr std::array<Pattern<3>, 6> e2ePatterns = {{
 		{9, 12, 5 }, // {1, 8, 4, 1, 1}, // A
@@ -169,7 +174,8 @@ static bool ChecksumIsValid(Character first)
 	return 0 <= i && i < Size(FINDER_PATTERN_SEQUENCES);
 }
 
-static Pair ReadPair(const PatternView& view, Direction dir)
+template <typename View>
+static Pair ReadPair(const View& view, Direction dir)
 {
 	if (int finder = ParseFinderPattern(Finder(view), dir))
 		if (auto charL = ReadDataCharacter(LeftChar(view), finder, false))
@@ -185,8 +191,8 @@ static Pair ReadPair(const PatternView& view, Direction dir)
 	return {};
 }
 
-template<bool STACKED>
-static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
+template<bool STACKED, typename View>
+static Pairs ReadRowOfPairs(View& next, int rowNumber)
 {
 	Pairs pairs;
 	Pair pair;
@@ -221,7 +227,7 @@ static Pairs ReadRowOfPairs(PatternView& next, int rowNumber)
 	}
 
 	auto flippedDir = [](Pair p) { return p.finder < 0 ? Direction::Right : Direction::Left; };
-	auto isValidPair = [](Pair p, PatternView v) { return p.right || IsGuard(v[p.finder < 0 ? 9 : 11], v[13]); };
+	auto isValidPair = [](Pair p, const View& v) { return p.right || IsGuard(v[p.finder < 0 ? 9 : 11], v[13]); };
 
 	do {
 		pair.y = rowNumber;
@@ -328,7 +334,8 @@ struct DBERState : public RowReader::DecodingState
 	PairMap allPairs;
 };
 
-BarcodeData DataBarExpandedReader::decodePattern(int rowNumber, PatternView& view, std::unique_ptr<RowReader::DecodingState>& state) const
+template <typename View>
+BarcodeData DataBarExpandedReader::decodeView(int rowNumber, View& view, std::unique_ptr<RowReader::DecodingState>& state) const
 {
 #if 0 // non-stacked version
 	auto pairs = ReadRowOfPairs<false>(view, rowNumber);
@@ -380,4 +387,14 @@ BarcodeData DataBarExpandedReader::decodePattern(int rowNumber, PatternView& vie
 			.lineCount = EstimateLineCount(pairs.front(), pairs.back())};
 }
 
+BarcodeData DataBarExpandedReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData DataBarExpandedReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
@@ -21,7 +21,8 @@ using namespace DataBar;
 constexpr int CHAR_LEN = 14;
 constexpr int SYMBOL_LEN = 1 + 3 * CHAR_LEN + 2;
 
-static Character ReadDataCharacter(const PatternView& view)
+template <typename View>
+static Character ReadDataCharacter(const View& view)
 {
 	constexpr int G_SUM[] = {0, 183064, 820064, 1000776, 1491021, 1979845, 1996939};
 	constexpr int T_EVEN[] = {28, 728, 6454, 203, 2408, 1, 16632};
@@ -97,7 +98,8 @@ std::array<int, 89> CheckChars = {
 	0b11'01010010'10011010, 0b11'01010010'01011010, 0b11'01001010'10011010, 0b11'01010101'10010010,
 };
 
-BarcodeData DataBarLimitedReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
+template <typename View>
+BarcodeData DataBarLimitedReader::decodeView(int rowNumber, View& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	next = next.subView(-2, SYMBOL_LEN);
 	while (next.shift(2)) {
@@ -149,4 +151,14 @@ BarcodeData DataBarLimitedReader::decodePattern(int rowNumber, PatternView& next
 	return {};
 }
 
+BarcodeData DataBarLimitedReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData DataBarLimitedReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
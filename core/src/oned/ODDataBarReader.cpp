@@ -22,23 +22,27 @@ namespace ZXing::OneD {
 
 using namespace DataBar;
 
-static bool IsCharacterPair(PatternView v, int modsLeft, int modsRight)
+template <typename View>
+static bool IsCharacterPair(View v, int modsLeft, int modsRight)
 {
 	float modSizeRef = ModSizeFinder(v);
 	return IsCharacter(LeftChar(v), modsLeft, modSizeRef) && IsCharacter(RightChar(v), modsRight, modSizeRef);
 }
 
-static bool IsLeftPair(const PatternView& v)
+template <typename View>
+static bool IsLeftPair(const View& v)
 {
 	return IsFinder(v[8], v[9], v[10], v[11], v[12]) && IsGuard(v[-1], v[11]) && IsCharacterPair(v, 16, 15);
 }
 
-static bool IsRightPair(const PatternView& v)
+template <typename View>
+static bool IsRightPair(const View& v)
 {
 	return IsFinder(v[12], v[11], v[10], v[9], v[8]) && IsGuard(v[9], v[21]) && IsCharacterPair(v, 15, 16);
 }
 
-static Character ReadDataCharacter(const PatternView& view, bool outsideChar, bool rightPair)
+template <typename View>
+static Character ReadDataCharacter(const View& view, bool outsideChar, bool rightPair)
 {
 	constexpr int OUTSIDE_EVEN_TOTAL_SUBSET[] = {1, 10, 34, 70, 126};
 	constexpr int INSIDE_ODD_TOTAL_SUBSET[]   = {4, 20, 48, 81};
@@ -85,7 +89,8 @@ static Character ReadDataCharacter(const PatternView& view, bool outsideChar, bo
 	}
 }
 
-int ParseFinderPattern(const PatternView& view, bool reversed)
+template <typename View>
+int ParseFinderPattern(const View& view, bool reversed)
 {
 	static constexpr std::array<Pattern<3>, 9> e2ePatterns = {{
 		{11, 10, 3 }, // {3, 8, 2, 1, 1}
@@ -102,7 +107,8 @@ int ParseFinderPattern(const PatternView& view, bool reversed)
 	return ParseFinderPattern(view, reversed, e2ePatterns);
 }
 
-static Pair ReadPair(const PatternView& view, bool rightPair)
+template <typename View>
+static Pair ReadPair(const View& view, bool rightPair)
 {
 	if (int pattern = ParseFinderPattern(Finder(view), rightPair))
 		if (auto outside = ReadDataCharacter(rightPair ? RightChar(view) : LeftChar(view), true, rightPair))
@@ -165,7 +171,8 @@ struct State : public RowReader::DecodingState
 	std::unordered_set<Pair, PairHash> rightPairs;
 };
 
-BarcodeData DataBarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>& state) const
+template <typename View>
+BarcodeData DataBarReader::decodeView(int rowNumber, View& next, std::unique_ptr<RowReader::DecodingState>& state) const
 {
 	if (!state)
 		state = std::make_unique<State>();
@@ -237,4 +244,14 @@ out:
 	return {};
 }
 
+BarcodeData DataBarReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData DataBarReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
@@ -15,12 +15,20 @@
 
 namespace ZXing::OneD {
 
-BarcodeData ITFReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>&) const
+constexpr auto START_PATTERN = FixedPattern<4, 4>{1, 1, 1, 1};
+constexpr int QUIET_ZONE = 6; // spec requires 10
+
+double ITFReader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio(START_PATTERN, QUIET_ZONE);
+}
+
+template <typename View>
+BarcodeData ITFReader::decodeView(int rowNumber, View& next, std::unique_ptr<DecodingState>&) const
 {
 	const int minCharCount = _opts.formats().size() == 1 ? 4 : 6; // if we are only looking for ITF, we accept shorter symbols
-	const int minQuietZone = 6; // spec requires 10
 
-	next = FindLeftGuard(next, 4 + 10 + 3, FixedPattern<4, 4>{1, 1, 1, 1}, minQuietZone);
+	next = FindLeftGuard(next, 4 + 10 + 3, START_PATTERN, QUIET_ZONE);
 	if (!next.isValid())
 		return {};
 
@@ -75,7 +83,7 @@ BarcodeData ITFReader::decodePattern(int rowNumber, PatternView& next, std::uniq
 		return {};
 
 	// Check quiet zone size (full quiet zone on both ends or cropped on both ends)
-	if (!(std::min((int)next[3], xStart) > minQuietZone * (threshold.bar + threshold.space) / 3
+	if (!(std::min((int)next[3], xStart) > QUIET_ZONE * (threshold.bar + threshold.space) / 3
 		  || (next.isAtLastBar() && startsAtFirstBar && std::max(xStart, (int)next[3]) < 2 * std::min(xStart, (int)next[3]) + 2)))
 		return {};
 
@@ -94,4 +102,14 @@ BarcodeData ITFReader::decodePattern(int rowNumber, PatternView& next, std::uniq
 	return LinearBarcode(BarcodeFormat::ITF, txt, rowNumber, xStart, xStop, symbologyIdentifier, error);
 }
 
+BarcodeData ITFReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData ITFReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
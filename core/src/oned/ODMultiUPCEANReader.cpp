@@ -43,7 +43,8 @@ constexpr float QUIET_ZONE_ADDON = 3;
 // There is a single sample (ean13-1/12.png) that fails to decode with these (new) settings because
 // it has a right-side quiet zone of only about 4.5 modules, which is clearly out of spec.
 
-static bool DecodeDigit(const PatternView& view, std::string& txt, int* lgPattern = nullptr)
+template <typename View>
+static bool DecodeDigit(const View& view, std::string& txt, int* lgPattern = nullptr)
 {
 #if 1
 	// These two values are critical for determining how permissive the decoding will be.
@@ -105,7 +106,8 @@ static bool DecodeDigit(const PatternView& view, std::string& txt, int* lgPatter
 #endif
 }
 
-static bool DecodeDigits(int digitCount, PatternView& next, std::string& txt, int* lgPattern = nullptr)
+template <typename View>
+static bool DecodeDigits(int digitCount, View& next, std::string& txt, int* lgPattern = nullptr)
 {
 	for (int j = 0; j < digitCount; ++j, next.skipSymbol())
 		if (!DecodeDigit(next, txt, lgPattern))
@@ -113,10 +115,11 @@ static bool DecodeDigits(int digitCount, PatternView& next, std::string& txt, in
 	return true;
 }
 
+template <typename View>
 struct PartialResult
 {
 	std::string txt;
-	PatternView end;
+	View end;
 	BarcodeFormat format = BarcodeFormat::None;
 
 	PartialResult() { txt.reserve(14); }
@@ -129,7 +132,8 @@ bool _ret_false_debug_helper()
 }
 #define CHECK(A) if(!(A)) return _ret_false_debug_helper();
 
-static bool EAN13(PartialResult& res, PatternView begin)
+template <typename View>
+static bool EAN13(PartialResult<View>& res, View begin)
 {
 	auto mid = begin.subView(27, MID_PATTERN.size());
 	auto end = begin.subView(56, END_PATTERN.size());
@@ -155,13 +159,15 @@ static bool EAN13(PartialResult& res, PatternView begin)
 	return true;
 }
 
-static bool PlausibleDigitModuleSize(PatternView begin, int start, int i, float moduleSizeRef)
+template <typename View>
+static bool PlausibleDigitModuleSize(View begin, int start, int i, float moduleSizeRef)
 {
 	float moduleSizeData = begin.subView(start + i * 4, 4).sum() / 7.f;
 	return std::abs(moduleSizeData / moduleSizeRef - 1) < 0.2f;
 }
 
-static bool EAN8(PartialResult& res, PatternView begin)
+template <typename View>
+static bool EAN8(PartialResult<View>& res, View begin)
 {
 	auto mid = begin.subView(19, MID_PATTERN.size());
 	auto end = begin.subView(40, END_PATTERN.size());
@@ -189,7 +195,8 @@ static bool EAN8(PartialResult& res, PatternView begin)
 	return true;
 }
 
-static bool UPCE(PartialResult& res, PatternView begin)
+template <typename View>
+static bool UPCE(PartialResult<View>& res, View begin)
 {
 	auto end = begin.subView(27, UPCE_END_PATTERN.size());
 
@@ -231,7 +238,8 @@ static int Ean5Checksum(const std::string& s)
 	return sum % 10;
 }
 
-static bool AddOn(PartialResult& res, PatternView begin, int digitCount)
+template <typename View>
+static bool AddOn(PartialResult<View>& res, View begin, int digitCount)
 {
 	auto ext = begin.subView(0, 3 + digitCount * 4 + (digitCount - 1) * 2);
 	CHECK(ext.isValid());
@@ -264,7 +272,13 @@ static bool AddOn(PartialResult& res, PatternView begin, int digitCount)
 	return true;
 }
 
-BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
+double MultiUPCEANReader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio(END_PATTERN, QUIET_ZONE_LEFT);
+}
+
+template <typename View>
+BarcodeData MultiUPCEANReader::decodeView(int rowNumber, View& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	const int minSize = 3 + 6*4 + 6; // UPC-E
 
@@ -272,7 +286,7 @@ BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, s
 	if (!next.isValid())
 		return {};
 
-	PartialResult res;
+	PartialResult<View> res;
 	auto begin = next;
 
 	if (!((((readEAN13 || readUPCA) && EAN13(res, begin)) || (readEAN8 && EAN8(res, begin)) || (readUPCE && UPCE(res, begin)))))
@@ -302,7 +316,7 @@ BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, s
 	next = res.end;
 
 	auto ext = res.end;
-	PartialResult addOnRes;
+	PartialResult<View> addOnRes;
 	if (_opts.eanAddOnSymbol() != EanAddOnSymbol::Ignore && ext.skipSymbol()
 		&& ext.skipSingle(static_cast<int>(begin.sum() * 3.5)) && (AddOn(addOnRes, ext, 5) || AddOn(addOnRes, ext, 2))) {
 		res.txt += addOnRes.txt;
@@ -320,4 +334,14 @@ BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, s
 						 JsonProp(BarcodeExtra::UPCE, upceTxt) + JsonProp(BarcodeExtra::EanAddOn, addOnRes.txt));
 }
 
+BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData MultiUPCEANReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
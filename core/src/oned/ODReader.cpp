@@ -8,6 +8,8 @@
 #include "ODReader.h"
 
 #include "BinaryBitmap.h"
+#include "BitMatrix.h"
+#include "Deadline.h"
 #include "ReaderOptions.h"
 #include "ODCodabarReader.h"
 #include "ODCode128Reader.h"
@@ -21,13 +23,23 @@
 #include "ODMultiUPCEANReader.h"
 #include "ODTelepenReader.h"
 #include "BarcodeData.h"
+#include "Range.h"
+#include "ThreadPool.h"
+#include "ZXConfig.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #ifdef PRINT_DEBUG
-#include "BitMatrix.h"
 #include "BitMatrixIO.h"
+
+#include <string>
 #endif
 
 namespace ZXing::OneD {
@@ -65,6 +77,243 @@ Reader::Reader(const ReaderOptions& opts) : ZXing::Reader(opts)
 
 Reader::~Reader() = default;
 
+// The pixels [left, right] of the rows [top, bottom] that are covered by a symbol which has been found often enough
+// already (see minLineCount). When looking for more than one symbol, the readers skip those pixels on the rows that
+// still contain the same number of bars there and the symbol is counted as found on them (see DoDecode).
+struct ClaimedSpan
+{
+	int left, right, top, bottom;
+	int bars; // the number of bars starting in [left, right] in the row that claimed the span
+	int symbol; // the index of the symbol in the results
+	int xStart, xStop; // its position in the row that claimed the span
+};
+
+// The number of bars of the row starting in the pixels [left, right]
+static int CountBars(const PatternRow& row, int left, int right)
+{
+	int n = 0;
+	for (int i = 1, pixel = row[0]; i < Size(row) && pixel <= right; i += 2) {
+		n += pixel >= left;
+		pixel += row[i] + (i + 1 < Size(row) ? row[i + 1] : 0);
+	}
+	return n;
+}
+
+// The [begin, end) index range of the windows of a row that are in a ClaimedSpan
+struct ClaimedWindows
+{
+	int begin, end;
+};
+
+// A window of a PatternView that might contain a left guard: the index of its first bar and the QuietZoneRatio() of the
+// space in front of it (see RowReader::guardQuietZoneRatio).
+struct GuardCandidate
+{
+	int index;
+	float ratio;
+};
+
+// The windows of a PatternView and of the ReversedPatternView of a PatternRow that are passed on to the readers (see DoDecode)
+class RowWindows
+{
+	int _size = 0;
+	std::vector<GuardCandidate> _guards[2]; // for the row as is and reversed
+	std::vector<ClaimedWindows> _claimed[2]; // for the row as is and reversed
+
+public:
+	// Classify all windows of the row in both directions in a single pass, only the ones with a ratio of at least minRatio
+	// are guard candidates. The spans are the ClaimedSpans of the row.
+	void init(const PatternRow& row, double minRatio, const std::vector<ClaimedSpan>& spans)
+	{
+		PatternView view(row);
+		_size = view.size();
+		for (int dir = 0; dir < 2; ++dir) {
+			_guards[dir].clear();
+			_claimed[dir].clear();
+		}
+		if (!_size)
+			return;
+
+		// the bar at index i of the row is the one at index _size - 2 - i of the reversed row, the space in front of it
+		// in the reversed row is the one behind it in the row
+		auto isClaimed = [&spans](int pixel) {
+			return std::any_of(spans.begin(), spans.end(), [pixel](auto& s) { return s.left <= pixel && pixel <= s.right; });
+		};
+		// the first bar has no quiet zone in front that could be checked
+		constexpr float NO_QUIET_ZONE = std::numeric_limits<float>::max();
+		for (int i = 0, pixel = row[0]; i < _size; pixel += view[i] + (i + 1 < _size ? view[i + 1] : 0), i += 2) {
+			auto barWidth = std::max<int>(view[i], 1) - 0.5f;
+			if (float ratio = i ? (view[i - 1] + 1) / barWidth : NO_QUIET_ZONE; minRatio && ratio >= minRatio)
+				_guards[0].push_back({i, ratio});
+			if (float ratio = i + 2 < _size ? (view[i + 1] + 1) / barWidth : NO_QUIET_ZONE; minRatio && ratio >= minRatio)
+				_guards[1].push_back({_size - 2 - i, ratio});
+
+			if (spans.empty())
+				continue;
+			if (auto& claimed = _claimed[0]; isClaimed(pixel)) {
+				if (!claimed.empty() && claimed.back().end == i)
+					claimed.back().end = i + 2;
+				else
+					claimed.push_back({i, i + 2});
+			}
+			// the first pixel of the bar in the reversed row is its last one in the row
+			if (auto& claimed = _claimed[1]; isClaimed(pixel + view[i] - 1)) {
+				int j = _size - 2 - i;
+				if (!claimed.empty() && claimed.back().begin == j + 2)
+					claimed.back().begin = j;
+				else
+					claimed.push_back({j, j + 2});
+			}
+		}
+		// the reversed row was processed from the back
+		std::reverse(_guards[1].begin(), _guards[1].end());
+		std::reverse(_claimed[1].begin(), _claimed[1].end());
+	}
+
+	// Move next to the first window (at or after next) of the row (a PatternView or ReversedPatternView) that might
+	// contain a left guard with at least the given ratio (0 means any window) and, if skipClaimed, is not claimed and
+	// limit it to the end of the unclaimed range. Returns false if there is none.
+	template <typename View>
+	bool seek(View& next, double ratio, bool skipClaimed) const
+	{
+		constexpr bool reversed = std::is_same_v<View, ReversedPatternView>;
+		const auto& guards = _guards[reversed];
+		const auto& claimed = _claimed[reversed];
+		int i = next.index();
+		while (i < _size) {
+			if (ratio) {
+				auto g = std::partition_point(guards.begin(), guards.end(), [i](const GuardCandidate& c) { return c.index < i; });
+				g = std::find_if(g, guards.end(), [ratio](const GuardCandidate& c) { return c.ratio >= ratio; });
+				if (g == guards.end())
+					return false;
+				i = g->index;
+			}
+			auto c = skipClaimed ? std::partition_point(claimed.begin(), claimed.end(), [i](auto& c) { return c.end <= i; })
+								 : claimed.end();
+			if (c != claimed.end() && c->begin <= i) {
+				i = c->end;
+				continue;
+			}
+			next.shift(i - next.index());
+			next = next.subView(0, (c != claimed.end() ? c->begin : _size) - i);
+			return true;
+		}
+		return false;
+	}
+};
+
+// The parallel lines DoDecode scans at a given angle (in degrees, clockwise). Unless sampled is set, the lines at 0 and 90
+// degrees are the rows of the image and of the image rotated by 90 degrees. All others are sampled from the BitMatrix with
+// a step of 1 pixel, so thin bars get sampled as densely as along the rows. The pixels outside of the image are white,
+// hence all lines have the same length and the points of the lines are a shifted copy of each other, so results found in
+// adjacent lines can be merged in line coordinates like the ones of the rows. In contrast to a row, a symbol at the first
+// or last bar of an oblique line is usually just clipped by it instead of filling the image, so these lines get an extra
+// 1 pixel bar at both ends to disable the special handling of symbols at the ends of a row (see PatternView::isAtFirstBar).
+class ScanLines
+{
+	const BinaryBitmap& _image;
+	const BitMatrix* _bits = nullptr;
+	double _angle = 0;
+	int _count = 0, _length = 0; // _length does not include the PAD pixels of oblique lines
+	bool _steep = false; // whether the main direction is y
+	PointF _dir; // the step along the line as (main direction, other direction)
+	int _offset = 0; // the coordinate in the other direction of the first pixel of line 0
+	std::vector<PointI> _steps; // the (main, other) offsets of the pixels of a line, the same for all lines
+
+	static constexpr int PAD = 2; // the extra bar and space at the ends of an oblique line
+
+	PointI step(int i) const
+	{
+		if (i >= 0 && i < Size(_steps))
+			return _steps[i];
+		return {narrow_cast<int>(std::lround(_dir.x * i)), narrow_cast<int>(std::lround(_dir.y * i))};
+	}
+
+public:
+	ScanLines(const BinaryBitmap& image, double angle, bool sampled = false)
+		: _image(image), _angle(angle), _count(image.height()), _length(image.width())
+	{
+		if (!sampled && (angle == 0 || angle == 90)) {
+			if (angle == 90)
+				std::swap(_count, _length);
+			return;
+		}
+
+		_bits = image.getBitMatrix();
+		if (!_bits) {
+			_count = 0;
+			return;
+		}
+		double rad = angle * std::numbers::pi / 180;
+		PointF d(std::cos(rad), std::sin(rad));
+		if ((_steep = std::abs(d.y) > std::abs(d.x))) {
+			d = {d.y, d.x};
+			std::swap(_count, _length);
+		}
+		_dir = d.x < 0 ? -d : d;
+		_length = narrow_cast<int>((_length - 1) / _dir.x) + 1;
+		_steps.reserve(_length);
+		for (int i = 0; i < _length; ++i)
+			_steps.push_back(step(i));
+		// the lines that cross the image, i.e. the first one touches its first pixel and the last one its last pixel
+		int shift = _steps.back().y;
+		_offset = std::min(0, -shift);
+		_count += std::abs(shift);
+	}
+
+	double angle() const { return _angle; }
+	bool isSampled() const { return _bits != nullptr; }
+	bool isOblique() const { return std::fmod(_angle, 90) != 0; }
+	int count() const { return _count; }
+	int pad() const { return isOblique() ? PAD : 0; }
+	int length() const { return _length + 2 * pad(); }
+
+	// the point of the image at position p.x of line p.y
+	PointI toImage(PointI p) const
+	{
+		if (!isSampled())
+			return _angle == 90 ? PointI(p.y, _length - 1 - p.x) : p;
+		auto s = step(p.x - pad());
+		return _steep ? PointI(p.y + _offset + s.y, s.x) : PointI(s.x, p.y + _offset + s.y);
+	}
+
+	bool getPatternRow(int line, PatternRow& res) const
+	{
+		if (!isSampled())
+			return _image.getPatternRow(line, _angle == 90 ? 90 : 0, res);
+
+		// only the pixels [begin, end) of the line are inside the image, the steps are monotonic
+		const int base = line + _offset, limit = _steep ? _bits->width() : _bits->height();
+		auto indexOfFirst = [&](auto isBefore) {
+			return narrow_cast<int>(std::partition_point(_steps.begin(), _steps.end(), isBefore) - _steps.begin());
+		};
+		int begin = indexOfFirst([&](PointI s) { return _dir.y < 0 ? base + s.y >= limit : base + s.y < 0; });
+		int end = indexOfFirst([&](PointI s) { return _dir.y < 0 ? base + s.y >= 0 : base + s.y < limit; });
+		if (begin >= end)
+			return false;
+		int pixelsBehind = _length - end;
+
+		ZX_THREAD_LOCAL std::vector<uint8_t> pixels; // reused between calls to save the (re-)allocations
+		pixels.resize(end - begin);
+		for (int i = begin; i < end; ++i) {
+			auto s = _steps[i];
+			pixels[i - begin] = _steep ? _bits->get(base + s.y, s.x) : _bits->get(s.x, base + s.y);
+		}
+		GetPatternRow(Range(pixels), res);
+		// the pixels outside of the image are white
+		res.front() += begin;
+		res.back() += pixelsBehind;
+		if (!pad())
+			return true;
+		// followed by the extra bars
+		res.front() += PAD - 1;
+		res.back() += PAD - 1;
+		res.insert(res.begin(), {0, 1});
+		res.insert(res.end(), {1, 0});
+		return Size(res) > 5;
+	}
+};
+
 /**
 * We're going to examine rows from the middle outward, searching alternately above and below the
 * middle, and farther out each time. rowStep is the number of rows between each successive
@@ -73,24 +322,27 @@ Reader::~Reader() = default;
 * rowStep is bigger as the image is taller, but is always at least 1. We've somewhat arbitrarily
 * decided that moving up and down by about 1/16 of the image is pretty good; we try more of the
 * image if "trying harder".
+* The rows are the given ScanLines, the oblique ones are only scanned with a fixed budget of OBLIQUE_LINES rows. All
+* positions are in line coordinates until the results are returned.
 */
-BarcodesData DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image, bool tryHarder,
-						 bool rotate, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
+BarcodesData DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, const BinaryBitmap& image, const ScanLines& lines,
+					  bool tryHarder, bool isPure, int maxSymbols, int minLineCount, bool returnErrors)
 {
+	constexpr int OBLIQUE_LINES = 32;
+
 	BarcodesData res;
 
 	std::vector<std::unique_ptr<RowReader::DecodingState>> decodingState(readers.size());
 
-	int width = image.width();
-	int height = image.height();
-
-	if (rotate)
-		std::swap(width, height);
+	int width = lines.length();
+	int height = lines.count();
 
 	int middle = height / 2;
 	// TODO: find a better heuristic/parameterization if maxSymbols != 1
-	int rowStep = std::max(1, height / ((tryHarder && !isPure) ? (maxSymbols == 1 ? 256 : 512) : 32));
-	int maxLines = tryHarder ?
+	int rowStep = std::max(1, height / (lines.isOblique()		   ? OBLIQUE_LINES
+										: tryHarder && !isPure ? (maxSymbols == 1 ? 256 : 512)
+															   : 32));
+	int maxLines = tryHarder || lines.isOblique() ?
 		height :	// Look at the whole image, not just the center
 		15;			// 15 rows spaced 1/32 apart is roughly the middle half of the image
 
@@ -100,19 +352,128 @@ BarcodesData DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, co
 		minLineCount = std::min(minLineCount, height);
 	std::vector<int> checkRows;
 
-	PatternRow bars;
+	// When looking for more than one symbol, the readers skip the pixels of a symbol that has been found often enough on
+	// the rows close to it, as long as they contain the same number of bars there. Otherwise each reader tries to decode
+	// it again on each of those rows. Instead, the symbol is counted as found on them, with the position it had in the
+	// row that claimed them (see ClaimedSpan). The stacked DataBar and DX film edge readers still see every row.
+	const bool claimSpans = maxSymbols != 1 && !isPure;
+	std::vector<ClaimedSpan> claims;
+	// the ClaimedSpans of the given row from the first count claims that it still matches
+	auto claimedSpans = [&](int rowNumber, int count, const PatternRow& row) {
+		std::vector<ClaimedSpan> spans;
+		for (int k = 0; k < count; ++k)
+			if (auto& c = claims[k]; c.top <= rowNumber && rowNumber <= c.bottom && CountBars(row, c.left, c.right) == c.bars)
+				spans.push_back(c);
+		return spans;
+	};
+
+	ZX_THREAD_LOCAL PatternRow bars; // reused between calls to save the (re-)allocations
 	bars.reserve(128); // e.g. EAN-13 has 59 bars/spaces
+	ZX_THREAD_LOCAL RowWindows windows;
+
+	// Instead of letting each reader search the whole row for its left guard, the windows that might contain one of them are
+	// classified once per row (see RowWindows) and each reader is only invoked on the ones it might accept. The bound is
+	// exact, so the results are the same as without this prefilter.
+	double minRatio = 0;
+	for (auto& reader : readers)
+		if (auto ratio = reader->guardQuietZoneRatio(); ratio && (!minRatio || ratio < minRatio))
+			minRatio = ratio;
+
+	// call onResult(r, result) for each result of reader r in the given row (read back to front if upsideDown, see
+	// ReversedPatternView), returns false as soon as onResult does.
+	auto decodeRow = [&](size_t r, int rowNumber, const PatternRow& row, const RowWindows& windows, bool upsideDown,
+						 std::unique_ptr<RowReader::DecodingState>& state, auto&& onResult) {
+		const double ratio = readers[r]->guardQuietZoneRatio();
+		auto decode = [&](auto next) {
+			do {
+				// the stacked DataBar and DX film edge readers need to see every row to collect their state
+				if (!windows.seek(next, ratio, !readers[r]->usesDecodingState()))
+					break;
+				BarcodeData result = readers[r]->decodePattern(rowNumber, next, state);
+				if ((result.isValid() || (returnErrors && result.error)) && !onResult(r, std::move(result)))
+					return false;
+				// make sure we make progress and we start the next try on a bar
+				next.shift(2 - (next.index() % 2));
+				next.extend();
+			} while (tryHarder && next.size());
+			return true;
+		};
+		return upsideDown ? decode(ReversedPatternView(row)) : decode(PatternView(row));
+	};
+
+	// With a ThreadPool, the next chunk of rows is fetched and decoded by all readers that do not depend on the rows seen
+	// before concurrently. The rows are then processed in the usual order below, using those results, while the stacked
+	// DataBar readers and the merging of the results are run serially as before. Hence the output is the same as
+	// without a ThreadPool. The chunks grow, so not too much work is wasted if we stop early (see maxSymbols).
+	struct DecodedRow
+	{
+		bool valid = false;
+		int claims = 0; // the number of claims that were known when the row was decoded
+		PatternRow bars;
+		std::vector<std::tuple<bool, size_t, BarcodeData>> results; // (upsideDown, reader, result)
+	};
+	std::vector<DecodedRow> decoded; // the rows [decodedBegin, decodedBegin + Size(decoded)) of the scan order
+	int decodedBegin = 0;
+	ThreadPool* pool = image.threads();
+	const bool concurrent = tryHarder && !isPure && pool && pool->concurrent();
+	int chunkSize = concurrent ? pool->size() : 0;
+
+	auto scanRow = [&](int i) {
+		int rowStepsAboveOrBelow = (i + 1) / 2;
+		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
+		return middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+	};
+
+	auto decodeChunk = [&](int begin) {
+		decodedBegin = begin;
+		decoded.resize(std::min(chunkSize, maxLines - begin));
+		chunkSize = std::min(2 * chunkSize, 16 * pool->size());
+		pool->parallelFor(Size(decoded), [&](int j, int) {
+			auto& d = decoded[j];
+			int rowNumber = scanRow(begin + j);
+			d.results.clear();
+			d.claims = Size(claims);
+			d.valid = rowNumber >= 0 && rowNumber < height && lines.getPatternRow(rowNumber, d.bars);
+			if (!d.valid)
+				return;
+			std::unique_ptr<RowReader::DecodingState> noState;
+			ZX_THREAD_LOCAL RowWindows rowWindows;
+			rowWindows.init(d.bars, minRatio, claimedSpans(rowNumber, d.claims, d.bars));
+			for (bool upsideDown : {false, true})
+				for (size_t r = 0; r < readers.size(); ++r)
+					if (!readers[r]->usesDecodingState())
+						decodeRow(r, rowNumber, d.bars, rowWindows, upsideDown, noState, [&](size_t, BarcodeData&& result) {
+							d.results.emplace_back(upsideDown, r, std::move(result));
+							return true;
+						});
+		});
+	};
+
+	// merge the position of another line of the symbol into the one known so far, returns the new lineCount
+	auto mergeLine = [&](BarcodeData& symbol, const Position& line) {
+		auto dTop = maxAbsComponent(symbol.position.topLeft() - line.topLeft());
+		auto dBot = maxAbsComponent(symbol.position.bottomLeft() - line.topLeft());
+		// the tie is broken in image coordinates
+		auto symbolSum = sumAbsComponent(lines.toImage(symbol.position[0]));
+		auto lineSum = sumAbsComponent(lines.toImage(line[0]));
+		if (dTop < dBot || (dTop == dBot && (lines.angle() == 90) ^ (symbolSum > lineSum))) {
+			symbol.position[0] = line[0];
+			symbol.position[1] = line[1];
+		} else {
+			symbol.position[2] = line[2];
+			symbol.position[3] = line[3];
+		}
+		return ++symbol.lineCount;
+	};
 
 #ifdef PRINT_DEBUG
 	BitMatrix dbg(width, height);
 #endif
 
-	for (int i = 0; i < maxLines; i++) {
+	for (int i = 0; i < maxLines && !Deadline::Expired(); i++) {
 
 		// Scanning from the middle out. Determine which row we're looking at next:
-		int rowStepsAboveOrBelow = (i + 1) / 2;
-		bool isAbove = (i & 0x01) == 0; // i.e. is x even?
-		int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+		int rowNumber = scanRow(i);
 		bool isCheckRow = false;
 		if (rowNumber < 0 || rowNumber >= height) {
 			// Oops, if we run off the top or bottom, stop
@@ -129,98 +490,129 @@ BarcodesData DoDecode(const std::vector<std::unique_ptr<RowReader>>& readers, co
 				continue;
 		}
 
-		if (!image.getPatternRow(rowNumber, rotate ? 90 : 0, bars))
+		DecodedRow* pre = nullptr;
+		if (concurrent && !isCheckRow) {
+			if (i >= decodedBegin + Size(decoded))
+				decodeChunk(i);
+			pre = &decoded[i - decodedBegin];
+		}
+
+		if (pre ? !pre->valid : !lines.getPatternRow(rowNumber, bars))
 			continue;
+		const PatternRow& row = pre ? pre->bars : bars;
+
+		// the claims of the rows before apply to all readers of this row, not the ones found in this row
+		const int rowClaims = Size(claims);
+		// if the row is affected by claims made after it was decoded, it is decoded again
+		if (pre && std::any_of(claims.begin() + pre->claims, claims.end(),
+							   [rowNumber](auto& c) { return c.top <= rowNumber && rowNumber <= c.bottom; }))
+			pre = nullptr;
+
+		// the symbols of the spans claimed in this row are not decoded again but counted as found
+		const auto spans = claimSpans ? claimedSpans(rowNumber, rowClaims, row) : std::vector<ClaimedSpan>();
+		for (auto& c : spans)
+			mergeLine(res[c.symbol], Line(rowNumber, c.xStart, c.xStop));
 
 #ifdef PRINT_DEBUG
 		bool val = false;
 		int x = 0;
-		for (auto b : bars) {
+		for (auto b : row) {
 			for(unsigned j = 0; j < b; ++j)
 				dbg.set(x++, rowNumber, val);
 			val = !val;
 		}
 #endif
 
-		// While we have the image data in a PatternRow, it's fairly cheap to reverse it in place to
-		// handle decoding upside down barcodes.
+		// Upside down barcodes are decoded from a ReversedPatternView of the same PatternRow, so the row is never
+		// rewritten and the windows of both directions are classified in a single pass (see RowWindows).
 		// TODO: the DataBarExpanded (stacked) decoder depends on seeing each line from both directions. This is
 		// 'surprising' and inconsistent. It also requires the decoderState to be shared between normal and reversed
 		// scans, which makes no sense in general because it would mix partial detection data from two codes of the same
 		// type next to each other. See also https://github.com/zxing-cpp/zxing-cpp/issues/87
+		bool haveWindows = false; // only needed if some readers are not already done via pre
 		for (bool upsideDown : {false, true}) {
-			// trying again?
-			if (upsideDown) {
-				// reverse the row and continue
-				std::reverse(bars.begin(), bars.end());
-			}
+
+			// returns false if we are done
+			auto onResult = [&](size_t reader, BarcodeData&& result) {
+				result.lineCount++;
+				int left = width, right = 0;
+				for (auto& p : result.position) {
+					left = std::min(left, p.x);
+					right = std::max(right, p.x);
+				}
+				if (upsideDown)
+					std::tie(left, right) = std::pair(width - 1 - right, width - 1 - left);
+				int lineCount = result.lineCount;
+
+				if (upsideDown) {
+					// update position (flip horizontally).
+					for (auto& p : result.position) {
+						p = {width - p.x - 1, p.y};
+					}
+				}
+				const int xStart = result.position[0].x, xStop = result.position[1].x;
+
+				// check if we know this code already
+				int symbol = Size(res);
+				for (auto& other : res) {
+					if (result == other) {
+						// merge the position information
+						lineCount = mergeLine(other, result.position);
+						symbol = narrow_cast<int>(&other - res.data());
+						// clear the result, so we don't insert it again below
+						result = BarcodeData();
+						break;
+					}
+				}
+
+				if (result.format != BarcodeFormat::None) {
+					res.push_back(std::move(result));
+
+					// if we found a valid code we have not seen before but a minLineCount > 1,
+					// add additional check rows above and below the current one
+					if (!isCheckRow && minLineCount > 1 && rowStep > 1) {
+						checkRows = {rowNumber - 1, rowNumber + 1};
+						if (rowStep > 2)
+							checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
+					}
+				}
+
+				auto isClaimed = [&](const ClaimedSpan& c) {
+					return c.symbol == symbol && c.left <= left && right <= c.right && c.top <= rowNumber && rowNumber <= c.bottom;
+				};
+				if (claimSpans && !readers[reader]->usesDecodingState() && lineCount >= minLineCount
+					&& std::none_of(claims.begin(), claims.end(), isClaimed)) {
+					// the margin is well below the quiet zone, so no neighboring symbol gets claimed
+					int band = (right - left) / 16, margin = (right - left) / 32;
+					claims.push_back({left - margin, right + margin, rowNumber - band, rowNumber + band,
+									  CountBars(row, left - margin, right + margin), symbol, xStart, xStop});
+				}
+
+				return !maxSymbols || Reduce(res, 0, [&](int s, const BarcodeData& r) {
+										  return s + (r.lineCount >= minLineCount);
+									  }) != maxSymbols;
+			};
+
 			// Look for a barcode
 			for (size_t r = 0; r < readers.size(); ++r) {
 				// If this is a pure symbol, then checking a single non-empty line is sufficient for all but the stacked
 				// DataBar codes. They are the only ones using the decodingState, which we can use as a flag here.
 				if (isPure && i && !decodingState[r])
 					continue;
+				// the stacked DataBar and DX film edge readers collect their state from adjacent rows of the symbol
+				if (lines.isOblique() && readers[r]->usesDecodingState())
+					continue;
 
-				PatternView next(bars);
-				do {
-					BarcodeData result = readers[r]->decodePattern(rowNumber, next, decodingState[r]);
-					if (result.isValid() || (returnErrors && result.error)) {
-						result.lineCount++;
-						if (upsideDown) {
-							// update position (flip horizontally).
-							for (auto& p : result.position) {
-								p = {width - p.x - 1, p.y};
-							}
-						}
-						if (rotate) {
-							for (auto& p : result.position) {
-								p = {p.y, width - p.x - 1};
-							}
-						}
-
-						// check if we know this code already
-						for (auto& other : res) {
-							if (result == other) {
-								// merge the position information
-								auto dTop = maxAbsComponent(other.position.topLeft() - result.position.topLeft());
-								auto dBot = maxAbsComponent(other.position.bottomLeft() - result.position.topLeft());
-								if (dTop < dBot || (dTop == dBot && rotate ^ (sumAbsComponent(other.position[0]) >
-																			  sumAbsComponent(result.position[0])))) {
-									other.position[0] = result.position[0];
-									other.position[1] = result.position[1];
-								} else {
-									other.position[2] = result.position[2];
-									other.position[3] = result.position[3];
-								}
-								other.lineCount++;
-								// clear the result, so we don't insert it again below
-								result = BarcodeData();
-								break;
-							}
-						}
-
-						if (result.format != BarcodeFormat::None) {
-							res.push_back(std::move(result));
-
-							// if we found a valid code we have not seen before but a minLineCount > 1,
-							// add additional check rows above and below the current one
-							if (!isCheckRow && minLineCount > 1 && rowStep > 1) {
-								checkRows = {rowNumber - 1, rowNumber + 1};
-								if (rowStep > 2)
-									checkRows.insert(checkRows.end(), {rowNumber - 2, rowNumber + 2});
-							}
-						}
-
-						if (maxSymbols && Reduce(res, 0, [&](int s, const BarcodeData& r) {
-											  return s + (r.lineCount >= minLineCount);
-										  }) == maxSymbols) {
+				if (pre && !readers[r]->usesDecodingState()) {
+					for (auto& [ud, rr, result] : pre->results)
+						if (ud == upsideDown && rr == r && !onResult(r, std::move(result)))
 							goto out;
-						}
-					}
-					// make sure we make progress and we start the next try on a bar
-					next.shift(2 - (next.index() % 2));
-					next.extend();
-				} while (tryHarder && next.size());
+				} else {
+					if (!std::exchange(haveWindows, true))
+						windows.init(row, minRatio, spans);
+					if (!decodeRow(r, rowNumber, row, windows, upsideDown, decodingState[r], onResult))
+						goto out;
+				}
 			}
 		}
 	}
@@ -237,22 +629,57 @@ out:
 
 	std::erase_if(res, [](auto&& r) { return r.format == BarcodeFormat::None; });
 
+	for (auto& r : res)
+		for (auto& p : r.position)
+			p = lines.toImage(p);
+
 #ifdef PRINT_DEBUG
-	SaveAsPBM(dbg, rotate ? "od-log-r.pnm" : "od-log.pnm");
+	SaveAsPBM(dbg, lines.angle() ? "od-log-" + std::to_string(std::lround(lines.angle())) + ".pnm" : "od-log.pnm");
 #endif
 
 	return res;
 }
 
+bool Reader::usesThreads() const
+{
+	// see DoDecode(), only worth it if many rows are scanned
+	return _opts.tryHarder() && !_opts.isPure();
+}
+
+bool Reader::truncatesAtMaxSymbols() const
+{
+	// see DoDecode(), maxSymbols changes the scanned rows and the lineCount of the symbols found when it stops
+	return false;
+}
+
 BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
 {
-	auto resH =
-		DoDecode(_readers, image, _opts.tryHarder(), false, _opts.isPure(), maxSymbols, _opts.minLineCount(), _opts.returnErrors());
+	const bool oblique = _opts.tryOblique() && !_opts.isPure();
+
+	auto resH = DoDecode(_readers, image, ScanLines(image, 0), _opts.tryHarder(), _opts.isPure(), maxSymbols, _opts.minLineCount(),
+						 _opts.returnErrors());
+	// With tryOblique, the columns are sampled from the BitMatrix like the oblique lines instead of reading the rotated image.
 	if ((!maxSymbols || Size(resH) < maxSymbols) && _opts.tryRotate()) {
-		auto resV = DoDecode(_readers, image, _opts.tryHarder(), true, _opts.isPure(), maxSymbols - Size(resH),
-								 _opts.minLineCount(), _opts.returnErrors());
+		auto resV = DoDecode(_readers, image, ScanLines(image, 90, oblique), _opts.tryHarder(), _opts.isPure(),
+							 maxSymbols - Size(resH), _opts.minLineCount(), _opts.returnErrors());
 		resH.insert(resH.end(), std::make_move_iterator(resV.begin()), std::make_move_iterator(resV.end()));
 	}
+
+	// Symbols at other angles are only found by the rows and columns if they are tall enough to be crossed completely by one
+	// of them. If nothing was found that way and tryOblique is set, scan a fixed budget of oblique lines every 22.5 degrees,
+	// starting next to the columns. A symbol between two of the angles may be found by both, the neighboring lines may
+	// also decode parts of it as some other symbol, hence only the first result in each area is kept.
+	if (resH.empty() && oblique) {
+		for (double angle : {67.5, 112.5, 45., 135., 22.5, 157.5}) {
+			if ((maxSymbols && Size(resH) >= maxSymbols) || Deadline::Expired())
+				break;
+			for (auto& r : DoDecode(_readers, image, ScanLines(image, angle), _opts.tryHarder(), _opts.isPure(),
+									maxSymbols - Size(resH), _opts.minLineCount(), _opts.returnErrors()))
+				if (std::none_of(resH.begin(), resH.end(),
+								 [&r](auto& o) { return HaveIntersectingBoundingBoxes(o.position, r.position); }))
+					resH.push_back(std::move(r));
+		}
+	}
 	return resH;
 }
 
@@ -26,6 +26,8 @@ public:
 	~Reader() override;
 
 	BarcodesData read(const BinaryBitmap& image, int maxSymbols) const override;
+	bool usesThreads() const override;
+	bool truncatesAtMaxSymbols() const override;
 
 private:
 	std::vector<std::unique_ptr<RowReader>> _readers;
@@ -65,6 +65,15 @@ public:
 	virtual ~RowReader() = default;
 
 	virtual BarcodeData decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const = 0;
+	/// The same for the reversed row, i.e. to look for upside down symbols without reversing the row.
+	virtual BarcodeData decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const = 0;
+
+	/// Whether decodePattern() depends on the rows seen before (via the DecodingState), otherwise rows can be decoded in any order.
+	virtual bool usesDecodingState() const { return false; }
+
+	/// A lower bound for the QuietZoneRatio() of the left guards decodePattern() looks for, 0 if unknown. Only the windows
+	/// at the first bar or with a quiet zone at least that large need to be passed to decodePattern() (see DoDecode).
+	virtual double guardQuietZoneRatio() const { return 0; }
 
 	/**
 	 * Determines how closely a set of observed counts of runs of black/white values matches a given
@@ -76,8 +85,8 @@ public:
 	 * @param maxIndividualVariance The most any counter can differ before we give up
 	 * @return ratio of total variance between counters and pattern compared to total pattern size
 	 */
-	template <typename CP, typename PP>
-	static float PatternMatchVariance(const CP* counters, const PP* pattern, size_t length, float maxIndividualVariance)
+	template <typename CI, typename PI>
+	static float PatternMatchVariance(CI counters, PI pattern, size_t length, float maxIndividualVariance)
 	{
 		int total = Reduce(counters, counters + length, 0);
 		int patternLength = Reduce(pattern, pattern + length, 0);
@@ -145,7 +154,8 @@ public:
 	 * @param view containing one character
 	 * @return threshold value for bars and spaces
 	 */
-	static BarAndSpaceI NarrowWideThreshold(const PatternView& view)
+	template <typename View>
+	static BarAndSpaceI NarrowWideThreshold(const View& view)
 	{
 		BarAndSpaceI m = {view[0], view[1]};
 		BarAndSpaceI M = m;
@@ -173,7 +183,8 @@ public:
 	 * @brief ToNarrowWidePattern takes a PatternView, calculates a NarrowWideThreshold and returns int where a '0' bit
 	 * means narrow and a '1' bit means 'wide'.
 	 */
-	static int NarrowWideBitPattern(const PatternView& view)
+	template <typename View>
+	static int NarrowWideBitPattern(const View& view)
 	{
 		const auto threshold = NarrowWideThreshold(view);
 		if (!threshold.isValid())
@@ -200,8 +211,8 @@ public:
 		return i == -1 ? 0 : alphabet[i];
 	}
 
-	template<typename INDEX, typename ALPHABET>
-	static char DecodeNarrowWidePattern(const PatternView& view, const INDEX& table, const ALPHABET& alphabet)
+	template<typename View, typename INDEX, typename ALPHABET>
+	static char DecodeNarrowWidePattern(const View& view, const INDEX& table, const ALPHABET& alphabet)
 	{
 		return LookupBitPattern(NarrowWideBitPattern(view), table, alphabet);
 	}
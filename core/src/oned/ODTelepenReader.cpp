@@ -37,17 +37,24 @@ static std::string DecodeNumeric(std::string_view encoded)
 	return decoded;
 }
 
-BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<RowReader::DecodingState>&) const
+constexpr int QUIET_ZONE = 5; // spec requires 10
+constexpr FixedPattern<6, 6> PREFIX_PATTERN = {1, 1, 1, 1, 1, 1};
+
+double TelepenReader::guardQuietZoneRatio() const
+{
+	return QuietZoneRatio<true>(PREFIX_PATTERN, QUIET_ZONE);
+}
+
+template <typename View>
+BarcodeData TelepenReader::decodeView(int rowNumber, View& next, std::unique_ptr<RowReader::DecodingState>&) const
 {
 	constexpr int minCharCount = 1; // TODO
-	constexpr int minQuietZone = 5; // spec requires 10
 	constexpr int minCharLength = 16 / 3;
 	constexpr FixedPattern<12, 16> startPatterns[3] = {
 		{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3}, // START 1: "Full ASCII" in AIM Spec
 		{1, 1, 1, 1, 1, 1, 1, 1, 3, 1, 1, 3}, // START 2: "Compressed Numeric (+ Full ASCII)" in AIM Spec
 		{1, 1, 1, 1, 1, 1, 3, 1, 1, 1, 1, 3}  // START 3: "Full ASCII + Compressed Numeric" in AIM Spec
 	};
-	constexpr FixedPattern<6, 6> prefixPattern = {1, 1, 1, 1, 1, 1};
 	constexpr FixedPattern<11, 15> endPatterns[3] = {
 		{3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1}, // STOP 1
 		{3, 1, 1, 3, 1, 1, 1, 1, 1, 1, 1}, // STOP 2
@@ -58,7 +65,7 @@ BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::
 	// data, see guess-work below.
 
 #if 0 // use fast 1:1:1:1 start pattern plausibility check, then E2E check for the whole start pattern
-	next = FindLeftGuard<12>(next, 2 * 12 + minCharCount * minCharLength, [=](const PatternView& view, int spaceInPixel) {
+	next = FindLeftGuard<12>(next, 2 * 12 + minCharCount * minCharLength, [=](const View& view, int spaceInPixel) {
 		// find min/max of 4 consecutive bars/spaces and make sure they are close together
 		auto mB = view[0], mS = view[1], MB = view[2], MS = view[3];
 		if (mB > MB)
@@ -66,17 +73,17 @@ BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::
 		if (mS > MS)
 			std::swap(mS, MS);
 		return MB <= mB * 4 / 3 + 1 && MS <= mS * 4 / 3 + 1 && MB < 2 * mS + 1 && MS < 2 * mB + 1
-			   && IsPattern<true>(view, startPattern, spaceInPixel, minQuietZone);
+			   && IsPattern<true>(view, startPattern, spaceInPixel, QUIET_ZONE);
 	});
 #else
-	next = FindLeftGuard<true>(next, 2 * 12 + minCharCount * minCharLength, prefixPattern, minQuietZone);
+	next = FindLeftGuard<true>(next, 2 * 12 + minCharCount * minCharLength, PREFIX_PATTERN, QUIET_ZONE);
 #endif
 	if (!next.isValid())
 		return {};
 
 	int startChar = 1;
 	for (; startChar < 4; ++startChar)
-		if (IsPattern<true>(next, startPatterns[startChar - 1], next.spaceInFront(), minQuietZone))
+		if (IsPattern<true>(next, startPatterns[startChar - 1], next.spaceInFront(), QUIET_ZONE))
 			break;
 	if (startChar == 4 || (startChar > 1 && !readNumeric))
 		return {};
@@ -94,7 +101,7 @@ BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::
 
 	next = next.subView(startPattern.size(), endPattern.size());
 	std::string raw;
-	while (next.isValid() && !IsRightGuard<true>(next, endPattern, minQuietZone)) {
+	while (next.isValid() && !IsRightGuard<true>(next, endPattern, QUIET_ZONE)) {
 		BitArray ba;
 		bool inBlock = false;
 		BarAndSpace<int> wSum, wNum, nSum, nNum;
@@ -139,7 +146,7 @@ BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::
 											  : threshold[i];
 	}
 
-	if (raw.size() < minCharCount + 1 || !IsRightGuard<true>(next, endPattern, minQuietZone))
+	if (raw.size() < minCharCount + 1 || !IsRightGuard<true>(next, endPattern, QUIET_ZONE))
 		return {};
 
 	auto txt = raw.substr(0, raw.size() - 1); // drop checksum character
@@ -193,4 +200,14 @@ BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::
 	return LinearBarcode(format, txt, rowNumber, xStart, xStop, symbologyIdentifier, error);
 }
 
+BarcodeData TelepenReader::decodePattern(int rowNumber, PatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
+BarcodeData TelepenReader::decodePattern(int rowNumber, ReversedPatternView& next, std::unique_ptr<DecodingState>& state) const
+{
+	return decodeView(rowNumber, next, state);
+}
+
 } // namespace ZXing::OneD
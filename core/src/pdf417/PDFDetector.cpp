@@ -314,10 +314,10 @@ bool HasStartPattern(const BitMatrix& m, bool rotate90)
 	for (int r = ROW_STEP; r < end; r += ROW_STEP) {
 		GetPatternRow(m, r, row, rotate90);
 
-		if (FindLeftGuard(row, minSymbolWidth, START_PATTERN, 2).isValid())
+		if (FindLeftGuard(PatternView(row), minSymbolWidth, START_PATTERN, 2).isValid())
 			return true;
-		std::reverse(row.begin(), row.end());
-		if (FindLeftGuard(row, minSymbolWidth, START_PATTERN, 2).isValid())
+		// look for the start pattern of an upside down symbol without reversing the row
+		if (FindLeftGuard(ReversedPatternView(row), minSymbolWidth, START_PATTERN, 2).isValid())
 			return true;
 	}
 
@@ -12,6 +12,7 @@
 #include "BitMatrix.h"
 #include "BitMatrixCursor.h"
 #include "ConcentricFinder.h"
+#include "Deadline.h"
 #include "GridSampler.h"
 #include "Log.h"
 #include "Matrix.h"
@@ -20,6 +21,7 @@
 #include "QRVersion.h"
 #include "Quadrilateral.h"
 #include "RegressionLine.h"
+#include "ZXConfig.h"
 
 #include <algorithm>
 #include <cmath>
@@ -49,7 +51,7 @@ PatternView FindPattern(const PatternView& view)
 	});
 }
 
-std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder)
+std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool tryHarder, FinderPatterns* inverted)
 {
 	constexpr int MIN_SKIP         = 3;           // 1 pixel/module times 3 modules/center
 	constexpr int MAX_MODULES_FAST = 20 * 4 + 17; // support up to version 20 for mobile clients
@@ -65,29 +67,29 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 
 	std::vector<ConcentricPattern> res;
 	[[maybe_unused]] int N = 0;
-	PatternRow row;
+	ZX_THREAD_LOCAL PatternRow row; // reused between calls to save the (re-)allocations
+	ZX_THREAD_LOCAL PatternRow invRow;
 
-	for (int y = skip - 1; y < height; y += skip) {
-		GetPatternRow(image, y, row, false);
-		PatternView next = row;
+	auto scanRow = [&](const PatternRow& patternRow, int y, bool isInverted, FinderPatterns& found) {
+		PatternView next = patternRow;
 
 		while (next = FindPattern(next), next.isValid()) {
 			PointF p(next.pixelsInFront() + next[0] + next[1] + next[2] / 2.0, y + 0.5);
 
 			// make sure p is not 'inside' an already found pattern area
-			if (FindIf(res, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == res.end()) {
+			if (FindIf(found, [p](const auto& old) { return distance(p, old) < old.size / 2; }) == found.end()) {
 				log(p);
 				N++;
 				auto width = 2 * next.sum(); // the factor 2 allows for a maximum aspect ratio of 4:1 due to perspective distortion
-				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p, width);
-				if (pattern && !Contains(res, *pattern)) {
+				auto pattern = LocateConcentricPattern<E2E>(image, PATTERN, p, width, isInverted);
+				if (pattern && !Contains(found, *pattern)) {
 					log(*pattern, 3);
 					log(*pattern + PointF(.2, 0), 3);
 					log(*pattern - PointF(.2, 0), 3);
 					log(*pattern + PointF(0, .2), 3);
 					log(*pattern - PointF(0, .2), 3);
-					assert(image.get(pattern->x, pattern->y));
-					res.push_back(*pattern);
+					assert(image.get(pattern->x, pattern->y) != isInverted);
+					found.push_back(*pattern);
 				}
 			}
 
@@ -95,9 +97,20 @@ std::vector<ConcentricPattern> FindFinderPatterns(const BitMatrix& image, bool t
 			next.skipPair();
 			next.extend();
 		}
+	};
+
+	for (int y = skip - 1; y < height && !Deadline::Expired(); y += skip) {
+		GetPatternRow(image, y, row, false);
+		scanRow(row, y, false, res);
+		// inverted symbols are searched for in the same row, only the polarity of the pattern row is swapped
+		if (inverted) {
+			invRow = row;
+			InvertPatternRow(invRow);
+			scanRow(invRow, y, true, *inverted);
+		}
 	}
 
-	log_l("FPs: FindPattern: %d, LocateConcentric: %d", N, Size(res));
+	log_l("FPs: FindPattern: %d, LocateConcentric: %d, inverted: %d", N, Size(res), inverted ? Size(*inverted) : 0);
 
 	return res;
 }
@@ -313,9 +326,9 @@ FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns)
 	return res;
 }
 
-static double EstimateModuleSize(const BitMatrix& image, ConcentricPattern a, ConcentricPattern b)
+static double EstimateModuleSize(const BitMatrix& image, ConcentricPattern a, ConcentricPattern b, bool inverted)
 {
-	BitMatrixCursorF cur(image, a, b - a);
+	BitMatrixCursorF cur(image, a, b - a, inverted);
 	assert(cur.isBlack());
 
 	auto pattern = ReadSymmetricPattern<5>(cur, a.size * 2);
@@ -332,10 +345,10 @@ struct DimensionEstimate
 	int err = 4;
 };
 
-static DimensionEstimate EstimateDimension(const BitMatrix& image, ConcentricPattern a, ConcentricPattern b)
+static DimensionEstimate EstimateDimension(const BitMatrix& image, ConcentricPattern a, ConcentricPattern b, bool inverted = false)
 {
-	auto ms_a = EstimateModuleSize(image, a, b);
-	auto ms_b = EstimateModuleSize(image, b, a);
+	auto ms_a = EstimateModuleSize(image, a, b, inverted);
+	auto ms_b = EstimateModuleSize(image, b, a, inverted);
 
 	if (ms_a < 0 || ms_b < 0)
 		return {};
@@ -402,7 +415,7 @@ static PerspectiveTransform Mod2Pix(int dimension, PointF brOffset, Quadrilatera
 	return {quad, pix};
 }
 
-static std::optional<PointF> LocateAlignmentPattern(const BitMatrix& image, int moduleSize, PointF estimate)
+static std::optional<PointF> LocateAlignmentPattern(const BitMatrix& image, int moduleSize, PointF estimate, bool inverted)
 {
 	log(estimate, 4);
 
@@ -419,7 +432,7 @@ static std::optional<PointF> LocateAlignmentPattern(const BitMatrix& image, int
 		auto cor = CenterOfRing(image, PointI(p), moduleSize * 3, 1, false);
 
 		// if we did not land on a black pixel the concentric pattern finder will fail
-		if (!cor || !image.get(*cor))
+		if (!cor || image.get(*cor) == inverted)
 			continue;
 
 		if (auto cor1 = CenterOfRing(image, PointI(*cor), moduleSize * 2, 1))
@@ -434,7 +447,7 @@ static std::optional<PointF> LocateAlignmentPattern(const BitMatrix& image, int
 	return {};
 }
 
-static const Version* ReadVersion(const BitMatrix& image, int dimension, const PerspectiveTransform& mod2Pix)
+static const Version* ReadVersion(const BitMatrix& image, int dimension, const PerspectiveTransform& mod2Pix, bool inverted)
 {
 	int bits[2] = {};
 
@@ -448,7 +461,7 @@ static const Version* ReadVersion(const BitMatrix& image, int dimension, const P
 				if (!image.isIn(pix))
 					versionBits = -1;
 				else
-					AppendBit(versionBits, image.get(pix));
+					AppendBit(versionBits, image.get(pix) != inverted);
 				log(pix, 3);
 			}
 		bits[static_cast<int>(mirror)] = versionBits;
@@ -457,10 +470,22 @@ static const Version* ReadVersion(const BitMatrix& image, int dimension, const P
 	return Version::DecodeVersionInformation(bits[0], bits[1]);
 }
 
-DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
+// The sampled bits of an inverted symbol are flipped, so the decoder always sees the normal polarity.
+static DetectorResult Polarized(DetectorResult&& res, bool inverted)
+{
+	if (!inverted || !res.isValid())
+		return std::move(res);
+
+	auto position = std::move(res).position();
+	auto bits = std::move(res).bits();
+	bits.flipAll();
+	return {std::move(bits), std::move(position)};
+}
+
+DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp, bool inverted)
 {
-	auto top  = EstimateDimension(image, fp.tl, fp.tr);
-	auto left = EstimateDimension(image, fp.tl, fp.bl);
+	auto top  = EstimateDimension(image, fp.tl, fp.tr, inverted);
+	auto left = EstimateDimension(image, fp.tl, fp.bl, inverted);
 
 	if (!top.dim && !left.dim)
 		co_return;
@@ -490,7 +515,7 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 		log(brInter, 3);
 
 		if (dimension > 21)
-			if (auto brCP = LocateAlignmentPattern(image, moduleSize, brInter))
+			if (auto brCP = LocateAlignmentPattern(image, moduleSize, brInter, inverted))
 				br = *brCP;
 
 		brFound = image.isIn(br);
@@ -508,7 +533,7 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 	auto mod2Pix = Mod2Pix(dimension, brOffset, {fp.tl, fp.tr, br, fp.bl});
 
 	if( dimension >= Version::SymbolSize(7, Type::Model2).x) {
-		auto version = ReadVersion(image, dimension, mod2Pix);
+		auto version = ReadVersion(image, dimension, mod2Pix, inverted);
 
 		// if the version bits are garbage -> discard the detection
 		if (!version || std::min(std::abs(version->dimension() - top.dim), std::abs(version->dimension() - left.dim)) > 8)
@@ -553,7 +578,7 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 
 				PointF guessed =
 					x * y == 0 ? bestGuessAPP(x, y) : bestGuessAPP(x - 1, y) + bestGuessAPP(x, y - 1) - bestGuessAPP(x - 1, y - 1);
-				if (auto found = LocateAlignmentPattern(image, moduleSize, guessed))
+				if (auto found = LocateAlignmentPattern(image, moduleSize, guessed, inverted))
 					apP.set(x, y, found);
 			}
 
@@ -579,7 +604,7 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 				// if we found 2 each, intersect the two lines that are formed by connecting the point pairs
 				if (Size(hori) == 2 && Size(verti) == 2) {
 					auto guessed = intersect(RegressionLine(hori[0], hori[1]), RegressionLine(verti[0], verti[1]));
-					auto found = LocateAlignmentPattern(image, moduleSize, guessed);
+					auto found = LocateAlignmentPattern(image, moduleSize, guessed, inverted);
 					// search again near that intersection and if the search fails, use the intersection
 					if (!found) log_l("location guessed at %dx%d", x, y);
 					apP.set(x, y, found ? *found : guessed);
@@ -589,11 +614,11 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 		if (auto c = apP.get(N, N))
 			mod2Pix = Mod2Pix(dimension, PointF(3, 3), {fp.tl, fp.tr, *c, fp.bl});
 
-		co_yield SampleGrid(image, dimension, dimension, mod2Pix, std::move(apP), apM, apM);
+		co_yield Polarized(SampleGrid(image, dimension, dimension, mod2Pix, std::move(apP), apM, apM), inverted);
 #endif
 	}
 	else
-		co_yield SampleGrid(image, dimension, dimension, mod2Pix);
+		co_yield Polarized(SampleGrid(image, dimension, dimension, mod2Pix), inverted);
 
 	// if we have not found the br alignment pattern, we check
 	// a) if we have a version 1 symbol and tried and failed with the intersection of the trace lines (#1086), or
@@ -604,7 +629,7 @@ DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp)
 			|| (EstimateTilt(fp) < 1.1 && !(bl2.isHighRes() && bl3.isHighRes() && tr2.isHighRes() && tr3.isHighRes()))))
 		{
 			mod2Pix = Mod2Pix(dimension, PointF(0, 0), {fp.tl, fp.tr, fp.tr - fp.tl + fp.bl, fp.bl});
-			co_yield SampleGrid(image, dimension, dimension, mod2Pix);
+			co_yield Polarized(SampleGrid(image, dimension, dimension, mod2Pix), inverted);
 		}
 }
 
@@ -761,7 +786,7 @@ DetectorResult DetectPureRMQR(const BitMatrix& image)
 	return {Deflate(image, dimW, dimH, top + moduleSize / 2, left + moduleSize / 2, moduleSize), std::move(pos)};
 }
 
-DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp)
+DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp, bool inverted)
 {
 	auto fpQuad = FindConcentricPatternCorners(image, fp, fp.size, 2);
 	if (!fpQuad)
@@ -780,14 +805,14 @@ DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp)
 
 	FormatInformation bestFI;
 	PerspectiveTransform bestPT;
-	BitMatrixCursorF cur(image, {}, {});
+	BitMatrixCursorF cur(image, {}, {}, inverted);
 
 	for (int i = 0; i < 4; ++i) {
 		auto mod2Pix = PerspectiveTransform(srcQuad, RotatedCorners(*fpQuad, i));
 
 		auto check = [&](int i, bool checkOne) {
 			auto p = mod2Pix(centered(FORMAT_INFO_COORDS[i]));
-			return image.isIn(p) && (!checkOne || image.get(p));
+			return image.isIn(p) && (!checkOne || cur.blackAt(p));
 		};
 
 		// check that we see both innermost timing pattern modules
@@ -821,10 +846,10 @@ DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp)
 	if (blackPixels > 2 * dim / 3)
 		return {};
 
-	return SampleGrid(image, dim, dim, bestPT);
+	return Polarized(SampleGrid(image, dim, dim, bestPT), inverted);
 }
 
-DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp)
+DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp, bool inverted)
 {
 	auto fpQuad = FindConcentricPatternCorners(image, fp, fp.size, 2);
 	if (!fpQuad)
@@ -842,7 +867,7 @@ DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp)
 
 	FormatInformation bestFI;
 	PerspectiveTransform bestPT;
-	BitMatrixCursorF cur(image, {}, {});
+	BitMatrixCursorF cur(image, {}, {}, inverted);
 
 	for (int i = 0; i < 4; ++i) {
 		auto mod2Pix = PerspectiveTransform(srcQuad, RotatedCorners(*fpQuad, i));
@@ -897,7 +922,7 @@ DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp)
 		return QuadrilateralF{tl, tr, br, bl};
 	};
 
-	if (auto found = LocateAlignmentPattern(image, fp.size / 7, bestPT(dim - PointF(3, 3)))) {
+	if (auto found = LocateAlignmentPattern(image, fp.size / 7, bestPT(dim - PointF(3, 3)), inverted)) {
 		log(*found, 2);
 		if (auto spQuad = FindConcentricPatternCorners(image, *found, fp.size / 2, 1)) {
 			auto dest = intersectQuads(*fpQuad, *spQuad);
@@ -912,7 +937,7 @@ DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp)
 		}
 	}
 
-	return SampleGrid(image, dim.x, dim.y, bestPT);
+	return Polarized(SampleGrid(image, dim.x, dim.y, bestPT), inverted);
 }
 
 } // namespace ZXing::QRCode
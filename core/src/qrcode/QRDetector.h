@@ -28,14 +28,19 @@ struct FinderPatternSet
 using FinderPatterns = std::vector<ConcentricPattern>;
 using FinderPatternSets = std::vector<FinderPatternSet>;
 
-FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder);
+/**
+ * Find the finder patterns of all symbols in the image. If inverted is not null, the finder patterns of inverted symbols
+ * (light on dark) are collected there as well, based on the same pattern row scan.
+ */
+FinderPatterns FindFinderPatterns(const BitMatrix& image, bool tryHarder, FinderPatterns* inverted = nullptr);
 FinderPatternSets GenerateFinderPatternSets(FinderPatterns& patterns);
 
 using DetectorResults = std::generator<DetectorResult>;
 
-DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp);
-DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp);
-DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp);
+// inverted means the finder patterns have been found with swapped polarity, the sampled bits are flipped accordingly
+DetectorResults SampleQR(const BitMatrix& image, const FinderPatternSet& fp, bool inverted = false);
+DetectorResult SampleMQR(const BitMatrix& image, const ConcentricPattern& fp, bool inverted = false);
+DetectorResult SampleRMQR(const BitMatrix& image, const ConcentricPattern& fp, bool inverted = false);
 
 DetectorResult DetectPureQR(const BitMatrix& image);
 DetectorResult DetectPureMQR(const BitMatrix& image);
@@ -10,6 +10,7 @@
 #include "BarcodeData.h"
 #include "BinaryBitmap.h"
 #include "ConcentricFinder.h"
+#include "Deadline.h"
 #include "DecoderResult.h"
 #include "DetectorResult.h"
 #include "Log.h"
@@ -58,33 +59,28 @@ void logFPSet(const FinderPatternSet& fps [[maybe_unused]])
 #endif
 }
 
-BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
+// Sample and decode the symbols defined by the given finder patterns, they all have the same polarity (see inverted).
+static void ReadSymbols(const BitMatrix& binImg, FinderPatterns& allFPs, bool inverted, const ReaderOptions& _opts, int maxSymbols,
+						BarcodesData& res)
 {
-	auto binImg = image.getBitMatrix();
-	if (binImg == nullptr)
-		return {};
-
-#ifdef PRINT_DEBUG
-	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
-#endif
-
-	if (_opts.isPure())
-		return ToVector(readPure(binImg, _opts));
-
-	auto allFPs = FindFinderPatterns(*binImg, _opts.tryHarder());
+	auto add = [&](DecoderResult&& decoderResult, DetectorResult&& detectorResult, BarcodeFormat format) {
+		res.emplace_back(MatrixBarcode(std::move(decoderResult), std::move(detectorResult), format));
+		res.back().isInverted = inverted;
+	};
 
 	std::vector<ConcentricPattern> usedFPs;
-	BarcodesData res;
-	
+
 	if (_opts.hasFormat(BarcodeFormat::QRCodeModel1 | BarcodeFormat::QRCodeModel2)) {
 		auto allFPSets = GenerateFinderPatternSets(allFPs);
 		for (const auto& fpSet : allFPSets) {
+			if (Deadline::Expired())
+				break;
 			if (Contains(usedFPs, fpSet.bl) || Contains(usedFPs, fpSet.tl) || Contains(usedFPs, fpSet.tr))
 				continue;
 
 			logFPSet(fpSet);
 
-			for (auto&& detectorResult: SampleQR(*binImg, fpSet)) {
+			for (auto&& detectorResult: SampleQR(binImg, fpSet, inverted)) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if ((decoderResult.content().symbology.modifier == '0' && !_opts.hasFormat(BarcodeFormat::QRCodeModel1))
 					|| (decoderResult.content().symbology.modifier == '1' && !_opts.hasFormat(BarcodeFormat::QRCodeModel2)))
@@ -95,7 +91,7 @@ BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
 					usedFPs.push_back(fpSet.tr);
 				}
 				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(MatrixBarcode(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::QRCode));
+					add(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::QRCode);
 					// if we found a valid symbol, we stop the inner loop
 					if (res.back().isValid() || (maxSymbols && Size(res) == maxSymbols))
 						break;
@@ -108,14 +104,16 @@ BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
 	
 	if (_opts.hasFormat(BarcodeFormat::MicroQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
 		for (const auto& fp : allFPs) {
+			if (Deadline::Expired())
+				break;
 			if (Contains(usedFPs, fp))
 				continue;
 
-			auto detectorResult = SampleMQR(*binImg, fp);
+			auto detectorResult = SampleMQR(binImg, fp, inverted);
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(MatrixBarcode(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::MicroQRCode));
+					add(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::MicroQRCode);
 					if (maxSymbols && Size(res) == maxSymbols)
 						break;
 				}
@@ -127,14 +125,16 @@ BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
 	if (_opts.hasFormat(BarcodeFormat::RMQRCode) && !(maxSymbols && Size(res) == maxSymbols)) {
 		// TODO proper
 		for (const auto& fp : allFPs) {
+			if (Deadline::Expired())
+				break;
 			if (Contains(usedFPs, fp))
 				continue;
 
-			auto detectorResult = SampleRMQR(*binImg, fp);
+			auto detectorResult = SampleRMQR(binImg, fp, inverted);
 			if (detectorResult.isValid()) {
 				auto decoderResult = Decode(detectorResult.bits());
 				if (decoderResult.isValid(_opts.returnErrors())) {
-					res.emplace_back(MatrixBarcode(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::RMQRCode));
+					add(std::move(decoderResult), std::move(detectorResult), BarcodeFormat::RMQRCode);
 					if (maxSymbols && Size(res) == maxSymbols)
 						break;
 				}
@@ -142,6 +142,30 @@ BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
 			}
 		}
 	}
+}
+
+BarcodesData Reader::read(const BinaryBitmap& image, int maxSymbols) const
+{
+	auto binImg = image.getBitMatrix();
+	if (binImg == nullptr)
+		return {};
+
+#ifdef PRINT_DEBUG
+	LogMatrixWriter lmw(log, *binImg, 5, "qr-log.pnm");
+#endif
+
+	if (_opts.isPure())
+		return ToVector(readPure(binImg, _opts));
+
+	// The inverted symbols are handled here instead of in a separate pass over a physically inverted image (see
+	// supportsInversion). Their finder patterns are collected during the same row scan and the polarity is passed on.
+	FinderPatterns invertedFPs;
+	auto allFPs = FindFinderPatterns(*binImg, _opts.tryHarder(), _opts.tryInvert() ? &invertedFPs : nullptr);
+
+	BarcodesData res;
+	ReadSymbols(*binImg, allFPs, false, _opts, maxSymbols, res);
+	if (!invertedFPs.empty() && !(maxSymbols && Size(res) == maxSymbols))
+		ReadSymbols(*binImg, invertedFPs, true, _opts, maxSymbols, res);
 
 	return res;
 }
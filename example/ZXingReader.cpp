@@ -48,13 +48,16 @@ static void PrintUsage(const char* exePath)
 			  << "    -norotate  Don't try rotated image during detection (faster)\n"
 			  << "    -noinvert  Don't search for inverted codes during detection (faster)\n"
 			  << "    -noscale   Don't try downscaled images during detection (faster)\n"
+			  << "    -oblique   Also look for short linear codes at oblique angles (slower)\n"
 			  << "    -formats <FORMAT[,...]>\n"
 			  << "               Only detect given format(s) (faster)\n"
 			  << "    -single    Stop after the first barcode is detected (faster)\n"
 			  << "    -ispure    Assume the image contains only a 'pure'/perfect code (faster)\n"
 			  << "    -errors    Include barcodes with errors (like checksum error)\n"
-			  << "    -binarizer <local|global|fixed>\n"
+			  << "    -binarizer <local|global|fixed|adaptive>\n"
 			  << "               Binarizer to be used for gray to binary conversion\n"
+			  << "    -window <size>\n"
+			  << "               Window size (in pixels) of the adaptive binarizer\n"
 			  << "    -mode <plain|eci|hri|escaped>\n"
 			  << "               Text mode used to render the raw byte content into text\n"
 			  << "    -1         Print only file name, content/error on one line per file/barcode (implies '-mode Escaped')\n"
@@ -93,6 +96,8 @@ static bool ParseOptions(int argc, char* argv[], ReaderOptions& options, CLI& cl
 			options.tryInvert(false);
 		} else if (is("-noscale")) {
 			options.tryDownscale(false);
+		} else if (is("-oblique")) {
+			options.tryOblique(true);
 #ifdef ZXING_EXPERIMENTAL_API
 		} else if (is("-denoise")) {
 			options.tryDenoise(true);
@@ -122,8 +127,14 @@ static bool ParseOptions(int argc, char* argv[], ReaderOptions& options, CLI& cl
 				options.binarizer(Binarizer::GlobalHistogram);
 			else if (is("fixed"))
 				options.binarizer(Binarizer::FixedThreshold);
+			else if (is("adaptive"))
+				options.binarizer(Binarizer::Adaptive);
 			else
 				return false;
+		} else if (is("-window")) {
+			if (++i == argc)
+				return false;
+			options.binarizerWindow(std::stoi(argv[i]));
 		} else if (is("-mode")) {
 			if (++i == argc)
 				return false;
@@ -54,14 +54,18 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 	}
 	row.back() = 0;
 
-	for (size_t r = 0; r < readers.size(); ++r) {
-		PatternView next(row);
+	auto decode = [&](auto next, size_t r) {
 		while (next.isValid()) {
 			readers[r]->decodePattern(0, next, decodingState[r]);
 			// make sure we make progress and we start the next try on a bar
 			next.shift(2 - (next.index() % 2));
 			next.extend();
 		}
+	};
+
+	for (size_t r = 0; r < readers.size(); ++r) {
+		decode(PatternView(row), r);
+		decode(ReversedPatternView(row), r);
 	}
 
 	return 0;
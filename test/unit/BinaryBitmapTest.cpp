@@ -0,0 +1,224 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "AdaptiveBinarizer.h"
+#include "BitMatrix.h"
+#include "GlobalHistogramBinarizer.h"
+#include "HybridBinarizer.h"
+#include "ThreadPool.h"
+#include "ThresholdBinarizer.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace ZXing;
+
+static std::unique_ptr<BinaryBitmap> CreateBitmap(int type, const ImageView& iv, ThreadPool* threads)
+{
+	switch (type) {
+	case 0: return std::make_unique<ThresholdBinarizer>(iv, 127, nullptr, threads);
+	case 1: return std::make_unique<GlobalHistogramBinarizer>(iv, nullptr, threads);
+	case 2: return std::make_unique<HybridBinarizer>(iv, nullptr, threads);
+	default: return std::make_unique<AdaptiveBinarizer>(iv, nullptr, threads);
+	}
+}
+
+TEST(BinaryBitmapTest, BandsMatchSerial)
+{
+	// a size that is not a multiple of the block size with a gradient and some texture
+	const int width = 517, height = 333;
+	std::vector<uint8_t> img(width * height * 3); // Lum followed by LumA
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			img[y * width + x] = img[width * height + 2 * (y * width + x)] = (x / 9 + y / 7) % 2 * 120 + x / 5 + y / 7;
+
+	ThreadPool threads(4);
+	for (auto iv : {ImageView(img.data(), width, height, ImageFormat::Lum),
+					ImageView(img.data() + width * height, width, height, ImageFormat::LumA)}) {
+		for (int type = 0; type < 4; ++type) {
+			auto serial = CreateBitmap(type, iv, nullptr);
+			auto banded = CreateBitmap(type, iv, &threads);
+			ASSERT_NE(serial->getBitMatrix(), nullptr);
+			EXPECT_EQ(*banded->getBitMatrix(), *serial->getBitMatrix()) << type;
+			EXPECT_EQ(*banded->getBitMatrix(true), *serial->getBitMatrix(true)) << type;
+		}
+	}
+}
+
+TEST(BinaryBitmapTest, TransposedIsRotated)
+{
+	// sizes around the block size of the rotation, with partial 8x8 sub-blocks at the right and bottom border
+	for (auto [width, height] : {std::pair{1, 1}, {7, 9}, {64, 64}, {130, 67}, {517, 333}}) {
+		std::vector<uint8_t> img(width * height);
+		for (int i = 0; i < width * height; ++i)
+			img[i] = (i * 7919 / 13 % 3) * 127;
+
+		ThresholdBinarizer bitmap(ImageView(img.data(), width, height, ImageFormat::Lum), 127);
+		const auto& m = *bitmap.getBitMatrix();
+		const auto& t = *bitmap.getBitMatrix(true);
+		ASSERT_EQ(t.width(), height);
+		ASSERT_EQ(t.height(), width);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				ASSERT_EQ(t.get(y, width - 1 - x), m.get(x, y)) << width << "x" << height << " @ " << x << "," << y;
+	}
+}
+
+TEST(BinaryBitmapTest, ConcurrentQueries)
+{
+	const int width = 400, height = 300;
+	std::vector<uint8_t> img(width * height);
+	for (int i = 0; i < width * height; ++i)
+		img[i] = (i / 13 % 2) * 255;
+
+	ThreadPool threads(4);
+	HybridBinarizer bitmap({img.data(), width, height, ImageFormat::Lum}, nullptr, &threads);
+
+	// the matrices are computed only once, even if several readers ask for them at the same time
+	std::vector<const BitMatrix*> matrices(16);
+	ThreadPool readers(4);
+	readers.parallelFor(Size(matrices), [&](int i, int) { matrices[i] = bitmap.getBitMatrix(i % 2); });
+
+	for (int i = 0; i < Size(matrices); ++i)
+		EXPECT_EQ(matrices[i], bitmap.getBitMatrix(i % 2));
+}
+
+TEST(BinaryBitmapTest, GlobalHistogramPatternRowDirections)
+{
+	const int width = 97, height = 61;
+	std::vector<uint8_t> img(width * height);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			img[y * width + x] = y == 5 ? 0 : (x / 3 + y / 4) % 2 * 150 + x / 2 + y;
+
+	GlobalHistogramBinarizer bitmap({img.data(), width, height, ImageFormat::Lum});
+
+	// a line scanned in the opposite direction gives the reversed pattern, regardless of which direction was scanned first
+	auto check = [&](int rotation, int row, int reverseRotation, int reverseRow) {
+		for (int pass = 0; pass < 2; ++pass) {
+			PatternRow fwd, bwd;
+			bool found = bitmap.getPatternRow(row, rotation, fwd);
+			ASSERT_EQ(bitmap.getPatternRow(reverseRow, reverseRotation, bwd), found) << rotation << " " << row;
+			std::reverse(bwd.begin(), bwd.end());
+			if (found) {
+				EXPECT_EQ(fwd, bwd) << rotation << " " << row;
+			}
+		}
+	};
+
+	for (int y = 0; y < height; ++y)
+		y % 2 ? check(0, y, 180, height - 1 - y) : check(180, height - 1 - y, 0, y);
+	for (int x = 0; x < width; ++x)
+		x % 2 ? check(90, x, 270, width - 1 - x) : check(270, width - 1 - x, 90, x);
+
+	PatternRow flat;
+	EXPECT_FALSE(bitmap.getPatternRow(5, 0, flat));
+	EXPECT_FALSE(bitmap.getPatternRow(height - 1 - 5, 180, flat));
+}
+
+TEST(BinaryBitmapTest, Close)
+{
+	// reference implementation: dilate and erode all pixels except the border ones
+	auto close = [](BitMatrix& m) {
+		auto sum = [](const BitMatrix& in, int x, int y) {
+			int res = 0;
+			for (int dy = -1; dy <= 1; ++dy)
+				for (int dx = -1; dx <= 1; ++dx)
+					res += in.get(x + dx, y + dy);
+			return res;
+		};
+
+		BitMatrix tmp(m.width(), m.height());
+		for (int y = 1; y < m.height() - 1; ++y)
+			for (int x = 1; x < m.width() - 1; ++x)
+				tmp.set(x, y, sum(m, x, y) > 0);
+		for (int y = 1; y < m.height() - 1; ++y)
+			for (int x = 1; x < m.width() - 1; ++x)
+				m.set(x, y, sum(tmp, x, y) == 9);
+	};
+
+	// large uniform black and white areas (also at the border) with some noise in between
+	for (auto [width, height] : {std::pair{3, 3}, {64, 33}, {130, 67}, {517, 333}}) {
+		std::vector<uint8_t> img(width * height);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x)
+				img[y * width + x] = (x / 70 + y / 50) % 2 && (x * 31 + y * 17) % 23 ? 0 : 255;
+
+		ThreadPool threads(4);
+		ThresholdBinarizer bitmap(ImageView(img.data(), width, height, ImageFormat::Lum), 127, nullptr, &threads);
+		auto original = bitmap.getBitMatrix()->copy();
+		auto expected = original.copy();
+		close(expected);
+
+		EXPECT_EQ(bitmap.close(), expected != original);
+		EXPECT_EQ(*bitmap.getBitMatrix(), expected) << width << "x" << height;
+		// the closing is idempotent
+		EXPECT_FALSE(bitmap.close());
+	}
+}
+
+TEST(BinaryBitmapTest, MaskStaysWhiteWhenInverted)
+{
+	// a black image with a masked square in the middle
+	const int width = 40, height = 30;
+	std::vector<uint8_t> img(width * height, 0);
+	ThresholdBinarizer bitmap(ImageView(img.data(), width, height, ImageFormat::Lum), 127);
+	bitmap.getBitMatrix(true);
+	bitmap.mask({QuadrilateralF(PointF(10, 10), PointF(20, 10), PointF(20, 20), PointF(10, 20))});
+
+	for (bool inverted : {true, false}) {
+		bitmap.invert();
+		ASSERT_EQ(bitmap.inverted(), inverted);
+		const auto& matrix = *bitmap.getBitMatrix();
+		const auto& transposed = *bitmap.getBitMatrix(true);
+		for (int y = 0; y < height; ++y)
+			for (int x = 0; x < width; ++x) {
+				// the pixels on the border of the region may or may not be masked
+				bool inside = x > 10 && x < 20 && y > 10 && y < 20;
+				bool outside = x < 10 || x > 20 || y < 10 || y > 20;
+				if (inside) {
+					EXPECT_FALSE(matrix.get(x, y)) << x << "," << y << " " << inverted;
+				} else if (outside) {
+					EXPECT_EQ(matrix.get(x, y), !inverted) << x << "," << y << " " << inverted;
+				}
+				EXPECT_EQ(transposed.get(y, width - 1 - x), matrix.get(x, y)) << x << "," << y << " " << inverted;
+			}
+	}
+}
+
+TEST(BinaryBitmapTest, HybridWithParentLayer)
+{
+	// a textured area surrounded by a uniform background, downscaled like the LumImagePyramid layers
+	const int width = 517, height = 333;
+	std::vector<uint8_t> img(width * height);
+	for (int y = 0; y < height; ++y)
+		for (int x = 0; x < width; ++x)
+			img[y * width + x] = x > 150 && x < 400 && y > 100 && y < 250 ? (x / 5 + y / 3) % 2 * 180 + x / 10 : 200 + x % 3;
+
+	HybridBinarizer full({img.data(), width, height, ImageFormat::Lum});
+	ASSERT_NE(full.getBitMatrix(), nullptr);
+
+	for (int factor : {2, 3, 4}) {
+		int w = width / factor, h = height / factor;
+		std::vector<uint8_t> small(w * h);
+		for (int y = 0; y < h; ++y)
+			for (int x = 0; x < w; ++x) {
+				int sum = factor * factor / 2;
+				for (int dy = 0; dy < factor; ++dy)
+					for (int dx = 0; dx < factor; ++dx)
+						sum += img[(y * factor + dy) * width + x * factor + dx];
+				small[y * w + x] = sum / (factor * factor);
+			}
+
+		ImageView iv(small.data(), w, h, ImageFormat::Lum);
+		HybridBinarizer withParent(iv, nullptr, nullptr, &full), withoutParent(iv);
+		EXPECT_EQ(*withParent.getBitMatrix(), *withoutParent.getBitMatrix()) << factor;
+	}
+}
@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Pattern.h"
+#include "PseudoRandom.h"
 
 #include "gtest/gtest.h"
 
@@ -64,3 +65,112 @@ TEST(PatternTest, WhiteBlack)
 		EXPECT_EQ(pr[2], 0);
 	}
 }
+
+TEST(PatternTest, RandomRuns)
+{
+	// compare the contiguous (8 pixels at a time) and the strided (one pixel at a time) code paths with a simple reference
+	PseudoRandom random(17);
+	for (int s = 1; s <= 200; ++s) {
+		std::vector<uint8_t> in(s);
+		PatternRow expected = {};
+		uint8_t v = random.next(0, 1) * 0xff;
+		if (v)
+			expected.push_back(0);
+		for (int x = 0; x < s;) {
+			int run = std::min(s - x, random.next(1, s % 3 ? 3 : 20));
+			std::fill_n(in.data() + x, run, v);
+			expected.push_back(run);
+			x += run;
+			v = ~v;
+		}
+		if (in.back())
+			expected.push_back(0);
+
+		GetPatternRow(Range{in}, pr);
+		EXPECT_EQ(pr, expected) << s;
+
+		GetPatternRow(Range<StrideIter<const uint8_t*>>{{in.data(), 1}, {in.data() + s, 1}}, pr);
+		EXPECT_EQ(pr, expected) << s;
+	}
+}
+
+TEST(PatternTest, QuietZoneRatio)
+{
+	// every window accepted by IsPattern needs to satisfy the bound returned by QuietZoneRatio
+	PseudoRandom random(42);
+	auto check = [&](auto E2E, const auto& pattern, double minQuietZone, std::array<int, 12> expected) {
+		constexpr bool e2e = decltype(E2E)::value;
+		const double ratio = QuietZoneRatio<e2e>(pattern, minQuietZone);
+		ASSERT_GT(ratio, 0);
+		int accepted = 0;
+		for (int i = 0; i < 100000; ++i) {
+			Pattern<12> widths = {};
+			int moduleSize = random.next(1, 12);
+			for (int x = 0; x < pattern.size(); ++x)
+				widths[x] = std::max(1, expected[x] * moduleSize + random.next(-moduleSize, moduleSize));
+			int spaceInPixel = random.next(0, 20 * moduleSize);
+			PatternView view(widths);
+			if (IsPattern<e2e>(view.subView(0, pattern.size()), pattern, spaceInPixel, minQuietZone)) {
+				++accepted;
+				EXPECT_GE((spaceInPixel + 1) / (widths[0] - 0.5), ratio) << spaceInPixel << " " << widths[0];
+			}
+		}
+		EXPECT_GT(accepted, 0);
+	};
+
+	check(std::false_type(), FixedPattern<3, 4>{2, 1, 1}, 5, {2, 1, 1});
+	check(std::false_type(), FixedPattern<4, 4>{1, 1, 1, 1}, 6, {1, 1, 1, 1});
+	check(std::false_type(), FixedSparsePattern<9, 6>{0, 2, 3, 5, 7, 8}, 4, {1, 3, 1, 1, 3, 1, 3, 1, 1});
+	check(std::true_type(), FixedPattern<6, 6>{1, 1, 1, 1, 1, 1}, 5, {1, 1, 1, 1, 1, 1});
+
+	EXPECT_EQ(QuietZoneRatio(FixedSparsePattern<4, 2>{1, 3}, 5), 0);
+	EXPECT_EQ(QuietZoneRatio(FixedPattern<3, 3>{1, 1, 1}, 0), 0);
+}
+
+TEST(PatternTest, ReversedFindLeftGuard)
+{
+	// looking for a left guard in the ReversedPatternView must give the same result as in the reversed row
+	constexpr auto PATTERN = FixedPattern<4, 6>{1, 1, 1, 3};
+	constexpr auto PATTERN_E2E = FixedPattern<4, 4>{1, 1, 1, 1};
+	PseudoRandom random(7);
+	int found = 0;
+	for (int i = 0; i < 2000; ++i) {
+		PatternRow row(2 * random.next(0, 12) + 3);
+		for (auto& v : row)
+			v = random.next(1, 4);
+		row.front() = random.next(0, 1) * random.next(1, 9);
+		row.back() = random.next(0, 1) * random.next(1, 9);
+		PatternRow reversed(row.rbegin(), row.rend());
+
+		for (int minSize : {0, 4, 7}) {
+			auto expected = FindLeftGuard(PatternView(reversed), minSize, PATTERN, 1.5);
+			auto guard = FindLeftGuard(ReversedPatternView(row), minSize, PATTERN, 1.5);
+			ASSERT_EQ(guard.isValid(), expected.isValid()) << i << " " << minSize;
+			if (guard.isValid()) {
+				++found;
+				EXPECT_EQ(guard.index(), expected.index());
+				EXPECT_EQ(guard.isAtFirstBar(), expected.isAtFirstBar());
+				EXPECT_EQ(guard.spaceInFront(), expected.spaceInFront());
+				EXPECT_EQ(guard.pixelsInFront(), expected.pixelsInFront());
+				EXPECT_EQ(guard.pixelsTillEnd(), expected.pixelsTillEnd());
+				for (int x = 0; x < guard.size(); ++x)
+					EXPECT_EQ(guard[x], expected[x]);
+			}
+
+			auto expectedE2E = FindLeftGuard<true>(PatternView(reversed), minSize, PATTERN_E2E, 1);
+			auto guardE2E = FindLeftGuard<true>(ReversedPatternView(row), minSize, PATTERN_E2E, 1);
+			ASSERT_EQ(guardE2E.isValid(), expectedE2E.isValid()) << i << " " << minSize;
+			if (guardE2E.isValid()) {
+				EXPECT_EQ(guardE2E.index(), expectedE2E.index());
+			}
+		}
+
+		ReversedPatternView view(row);
+		PatternView expected(reversed);
+		EXPECT_EQ(view.size(), expected.size());
+		EXPECT_EQ(view.sum(), expected.sum());
+		for (int offset = 0; offset + 1 < view.size(); offset += 2)
+			EXPECT_EQ(view.subView(offset, 1).isAtLastBar(), expected.subView(offset, 1).isAtLastBar());
+	}
+	EXPECT_GT(found, 100);
+}
@@ -0,0 +1,349 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReadBarcodeUtility.h"
+#include "oned/ODCode128Writer.h"
+#include "qrcode/QRWriter.h"
+
+#include "gtest/gtest.h"
+
+using namespace ZXing;
+
+static Matrix<uint8_t> CreateQRCodeImage(const std::string& text, int size)
+{
+	return ToMatrix<uint8_t>(QRCode::Writer().setMargin(4).encode(text, size, size));
+}
+
+TEST(ReadBarcodeTest, ReaderSessionReuse)
+{
+	auto opts = ReaderOptions().formats(BarcodeFormat::QRCode);
+	ReaderSession session(opts);
+
+	// the first two images have the same size (buffers get reused), the third one is bigger (buffers get reallocated)
+	for (auto [text, size] : {std::pair{"Frame 1", 100}, {"Frame 2", 100}, {"Frame 3", 700}}) {
+		auto img = CreateQRCodeImage(text, size);
+		auto expected = ReadBarcodes(ToImageView(img), opts);
+		auto barcodes = session.read(ToImageView(img));
+
+		ASSERT_EQ(barcodes.size(), 1);
+		EXPECT_EQ(barcodes[0].text(), text);
+		EXPECT_EQ(barcodes, expected);
+		EXPECT_EQ(barcodes[0].position(), expected[0].position());
+	}
+}
+
+TEST(ReadBarcodeTest, ReaderSessionMove)
+{
+	ReaderSession session(ReaderOptions().formats(BarcodeFormat::QRCode).textMode(TextMode::Hex));
+	ReaderSession moved = std::move(session);
+
+	auto img = CreateQRCodeImage("A", 100);
+	auto barcodes = moved.read(ToImageView(img));
+
+	ASSERT_EQ(barcodes.size(), 1);
+	EXPECT_EQ(barcodes[0].text(), "41");
+	EXPECT_EQ(moved.options().textMode(), TextMode::Hex);
+}
+
+#ifdef __cpp_lib_span
+TEST(ReadBarcodeTest, ReadBarcodesBatch)
+{
+	auto opts = ReaderOptions().formats(BarcodeFormat::QRCode);
+
+	std::vector<Matrix<uint8_t>> imgs;
+	for (int i = 0; i < 10; ++i)
+		imgs.push_back(CreateQRCodeImage("Image " + std::to_string(i), 100 + 20 * i));
+
+	std::vector<ImageView> ivs;
+	for (auto& img : imgs)
+		ivs.push_back(ToImageView(img));
+
+	for (int threads : {1, 3}) {
+		auto res = ReadBarcodesBatch(ivs, opts, threads);
+
+		ASSERT_EQ(res.size(), imgs.size());
+		for (size_t i = 0; i < res.size(); ++i) {
+			ASSERT_EQ(res[i].size(), 1);
+			EXPECT_EQ(res[i][0].text(), "Image " + std::to_string(i));
+			EXPECT_EQ(res[i], ReadBarcodes(ivs[i], opts));
+		}
+	}
+
+	EXPECT_TRUE(ReadBarcodesBatch({}, opts).empty());
+}
+#endif
+
+TEST(ReadBarcodeTest, MaxThreads)
+{
+	auto img = CreateQRCodeImage("Threads", 600);
+	auto inverted = img.copy();
+	for (auto& v : inverted)
+		v = 255 - v;
+
+	for (int maxSymbols : {0, 1})
+		for (auto* i : {&img, &inverted})
+			EXPECT_EQ(ExpectSameWithThreads(ToImageView(*i), ReaderOptions().maxNumberOfSymbols(maxSymbols)).size(), 1);
+}
+
+TEST(ReadBarcodeTest, MaxThreadsMaxSymbols)
+{
+	// the QRCode reader finds less than maxNumberOfSymbols, the linear reader that runs after it (or concurrently) more
+	Matrix<uint8_t> img(600, 500, 255);
+	auto qrcode = CreateQRCodeImage("Matrix", 200);
+	for (int y = 0; y < 200; ++y)
+		for (int x = 0; x < 200; ++x)
+			img.set(x, y, qrcode.get(x, y));
+	for (int i = 0; i < 2; ++i) {
+		auto code128 = ToMatrix<uint8_t>(OneD::Code128Writer().encode("Linear " + std::to_string(i), 300, 100));
+		for (int y = 0; y < 100; ++y)
+			for (int x = 0; x < 300; ++x)
+				img.set(250 + x, 50 + 250 * i + y, code128.get(x, y));
+	}
+
+	// the position and lineCount of the linear symbols depend on the maxSymbols the linear reader was called with
+	for (int maxSymbols : {1, 2, 3, 0})
+		EXPECT_EQ(ExpectSameWithThreads(ToImageView(img), ReaderOptions().maxNumberOfSymbols(maxSymbols)).size(),
+				  maxSymbols ? maxSymbols : 3);
+}
+
+#ifdef ZXING_EXPERIMENTAL_API
+TEST(ReadBarcodeTest, MaxThreadsTryDenoise)
+{
+	// a normal, an inverted and a noisy symbol, the latter can only be read in the closed pass of the full resolution
+	// layer, and (in the serial code) before the next layer is looked at
+	Matrix<uint8_t> img(1200, 400, 255);
+	for (int i = 0; i < 3; ++i) {
+		auto modules = QRCode::Writer().setMargin(4).encode("Denoise " + std::to_string(i), 0, 0);
+		const int scale = 300 / modules.width();
+		for (int y = 0; y < modules.height() * scale; ++y)
+			for (int x = 0; x < modules.width() * scale; ++x) {
+				bool black = modules.get(x / scale, y / scale);
+				// punch a single white pixel hole into the center of every black module
+				if (i == 2 && x % scale == scale / 2 && y % scale == scale / 2)
+					black = false;
+				img.set(50 + 400 * i + x, 50 + y, (black != (i == 1)) ? 0 : 255);
+			}
+	}
+
+	for (int maxSymbols : {1, 2, 3, 0}) {
+		auto opts = ReaderOptions().formats(BarcodeFormat::QRCode).tryDenoise(true).maxNumberOfSymbols(maxSymbols);
+		EXPECT_EQ(ExpectSameWithThreads(ToImageView(img), opts).size(), maxSymbols ? maxSymbols : 3);
+	}
+}
+#endif
+
+TEST(ReadBarcodeTest, CoarseToFine)
+{
+	// big enough to result in a 3 layer pyramid
+	auto img = CreateQRCodeImage("Coarse", 1600);
+	auto expected = ReadBarcodes(ToImageView(img), ReaderOptions().formats(BarcodeFormat::QRCode));
+	ASSERT_EQ(expected.size(), 1);
+
+	for (int threads : {1, 2}) {
+		auto opts = ReaderOptions().formats(BarcodeFormat::QRCode).coarseToFine(true).maxThreads(threads);
+		auto barcodes = ReadBarcodes(ToImageView(img), opts);
+
+		// the symbol is found in a downscaled layer and masked out of the full resolution one
+		ASSERT_EQ(barcodes.size(), 1);
+		EXPECT_EQ(barcodes, expected);
+		for (int i = 0; i < 4; ++i)
+			EXPECT_LE(maxAbsComponent(barcodes[0].position()[i] - expected[0].position()[i]), 9);
+	}
+}
+
+TEST(ReadBarcodeTest, RegionsOfInterest)
+{
+	// three symbols next to each other
+	Matrix<uint8_t> img(600, 200);
+	for (int i = 0; i < 3; ++i) {
+		auto symbol = CreateQRCodeImage("ROI " + std::to_string(i), 200);
+		for (int y = 0; y < 200; ++y)
+			for (int x = 0; x < 200; ++x)
+				img.set(i * 200 + x, y, symbol.get(x, y));
+	}
+
+	auto opts = ReaderOptions().formats(BarcodeFormat::QRCode);
+	auto all = ReadBarcodes(ToImageView(img), opts);
+	ASSERT_EQ(all.size(), 3);
+
+	auto barcodes = ReadBarcodes(ToImageView(img), ReaderOptions(opts).regionsOfInterest({{195, -10, 210, 300}}));
+	ASSERT_EQ(barcodes.size(), 1);
+	EXPECT_EQ(barcodes[0].text(), "ROI 1");
+	EXPECT_EQ(barcodes[0].position(), all[1].position());
+
+	// the bounding box of the two regions contains the middle symbol, which has to be ignored
+	barcodes = ReadBarcodes(ToImageView(img), ReaderOptions(opts).regionsOfInterest({{0, 0, 200, 200}, {400, 0, 300, 300}}));
+	ASSERT_EQ(barcodes.size(), 2);
+	EXPECT_EQ(barcodes[0].text(), "ROI 0");
+	EXPECT_EQ(barcodes[1].text(), "ROI 2");
+	EXPECT_EQ(barcodes[1].position(), all[2].position());
+
+	EXPECT_TRUE(ReadBarcodes(ToImageView(img), ReaderOptions(opts).regionsOfInterest({{700, 0, 100, 100}})).empty());
+}
+
+TEST(ReadBarcodeTest, Tracking)
+{
+	auto symbol = CreateQRCodeImage("Track", 150);
+	auto frame = [&](int dx, int dy) {
+		Matrix<uint8_t> img(400, 300, 255);
+		if (dx >= 0)
+			for (int y = 0; y < symbol.height(); ++y)
+				for (int x = 0; x < symbol.width(); ++x)
+					img.set(dx + x, dy + y, symbol.get(x, y));
+		return img;
+	};
+
+	auto opts = ReaderOptions().formats(BarcodeFormat::QRCode | BarcodeFormat::DataMatrix);
+	ReaderSession session(opts);
+
+	// the symbol moves a few pixels per frame, the first one is a full search
+	for (int i = 0; i < 5; ++i) {
+		auto img = frame(100 + 6 * i, 50 + 4 * i);
+		auto barcodes = session.track(ToImageView(img));
+		auto expected = ReadBarcodes(ToImageView(img), opts);
+		ASSERT_EQ(barcodes.size(), 1);
+		EXPECT_EQ(barcodes[0].text(), "Track");
+		EXPECT_EQ(barcodes[0].position(), expected[0].position());
+	}
+
+	// the symbol disappeared (falls back to a full search) and comes back somewhere else
+	auto empty = frame(-1, 0);
+	EXPECT_TRUE(session.track(ToImageView(empty)).empty());
+	auto img = frame(220, 120);
+	auto barcodes = session.track(ToImageView(img));
+	ASSERT_EQ(barcodes.size(), 1);
+	EXPECT_EQ(barcodes[0].text(), "Track");
+
+	// the symbol moves partially out of the region of interest, the tracking window is clipped to it
+	auto roiOpts = ReaderOptions(opts).regionsOfInterest({{0, 0, 200, 300}});
+	ReaderSession roiSession(roiOpts);
+	for (int dx : {40, 70}) {
+		auto img = frame(dx, 50);
+		auto barcodes = roiSession.track(ToImageView(img));
+		EXPECT_EQ(barcodes.size(), dx == 40 ? 1 : 0) << dx;
+		EXPECT_EQ(barcodes, ReadBarcodes(ToImageView(img), roiOpts)) << dx;
+	}
+}
+
+TEST(ReadBarcodeTest, TimeBudget)
+{
+	using namespace std::chrono_literals;
+
+	auto img = CreateQRCodeImage("Budget", 1000);
+
+	for (int threads : {1, 2}) {
+		auto opts = ReaderOptions().maxThreads(threads);
+
+		ReaderSession unlimited(opts);
+		EXPECT_EQ(unlimited.read(ToImageView(img)).size(), 1);
+		EXPECT_FALSE(unlimited.partial());
+
+		ReaderSession generous(ReaderOptions(opts).timeBudget(10s));
+		EXPECT_EQ(generous.read(ToImageView(img)).size(), 1);
+		EXPECT_FALSE(generous.partial());
+
+		ReaderSession tight(ReaderOptions(opts).timeBudget(1us));
+		EXPECT_TRUE(tight.read(ToImageView(img)).empty());
+		EXPECT_TRUE(tight.partial());
+
+		// the same without a session
+		bool partial = true;
+		EXPECT_EQ(ReadBarcodes(ToImageView(img), ReaderOptions(opts).timeBudget(10s), partial).size(), 1);
+		EXPECT_FALSE(partial);
+		EXPECT_TRUE(ReadBarcodes(ToImageView(img), ReaderOptions(opts).timeBudget(1us), partial).empty());
+		EXPECT_TRUE(partial);
+	}
+}
+
+TEST(ReadBarcodeTest, CancelBeforeRead)
+{
+	auto img = CreateQRCodeImage("Cancel", 1000);
+
+	// a cancel() that arrives before the call starts is not lost, the call after that is not affected
+	ReaderSession session;
+	session.cancel();
+	EXPECT_TRUE(session.read(ToImageView(img)).empty());
+	EXPECT_TRUE(session.partial());
+	EXPECT_EQ(session.read(ToImageView(img)).size(), 1);
+	EXPECT_FALSE(session.partial());
+
+	session.cancel();
+	EXPECT_TRUE(session.track(ToImageView(img)).empty());
+	EXPECT_TRUE(session.partial());
+	EXPECT_EQ(session.track(ToImageView(img)).size(), 1);
+}
+
+TEST(ReadBarcodeTest, InterleavedLum)
+{
+	auto img = CreateQRCodeImage("Interleaved", 300);
+
+	// luminance in every other byte, like a LumA image or the Y channel of a YUYV camera frame
+	std::vector<uint8_t> buffer(img.size() * 2);
+	for (int i = 0; i < img.size(); ++i) {
+		buffer[2 * i] = img.data()[i];
+		buffer[2 * i + 1] = i % 3 * 100;
+	}
+
+	for (auto binarizer : {Binarizer::LocalAverage, Binarizer::GlobalHistogram, Binarizer::Adaptive}) {
+		auto opts = ReaderOptions().binarizer(binarizer);
+		auto expected = ReadBarcodes(ToImageView(img), opts);
+		ASSERT_EQ(expected.size(), 1);
+
+		for (auto format : {ImageFormat::Lum, ImageFormat::LumA}) {
+			auto barcodes = ReadBarcodes({buffer.data(), img.width(), img.height(), format, img.width() * 2, 2}, opts);
+			EXPECT_EQ(barcodes, expected);
+			ASSERT_EQ(barcodes.size(), 1);
+			EXPECT_EQ(barcodes[0].position(), expected[0].position());
+		}
+	}
+}
+
+TEST(ReadBarcodeTest, AdaptiveBinarizerUnevenLighting)
+{
+	auto img = CreateQRCodeImage("Uneven lighting", 400);
+
+	// a strong horizontal gradient from almost dark to bright with a round shadow on top
+	for (int y = 0; y < img.height(); ++y)
+		for (int x = 0; x < img.width(); ++x) {
+			float light = 0.15f + 0.85f * x / img.width();
+			if ((x - 150) * (x - 150) + (y - 250) * (y - 250) < 80 * 80)
+				light *= 0.5f;
+			img.set(x, y, uint8_t((img(x, y) ? 230 : 30) * light));
+		}
+
+	auto opts = ReaderOptions().binarizer(Binarizer::Adaptive).tryHarder(false).tryInvert(false).tryDownscale(false);
+	for (int window : {0, 120}) {
+		auto barcodes = ReadBarcodes(ToImageView(img), ReaderOptions(opts).binarizerWindow(window));
+		ASSERT_EQ(barcodes.size(), 1) << window;
+		EXPECT_EQ(barcodes[0].text(), "Uneven lighting");
+	}
+
+	// a window smaller than the center of the finder patterns hollows them out
+	EXPECT_TRUE(ReadBarcodes(ToImageView(img), ReaderOptions(opts).binarizerWindow(15)).empty());
+}
+
+TEST(ReadBarcodeTest, InvertedQRCodeInSameImage)
+{
+	// a normal and an inverted symbol next to each other, both are found while scanning the (not inverted) image once
+	Matrix<uint8_t> img(400, 200);
+	for (int i = 0; i < 2; ++i) {
+		auto symbol = CreateQRCodeImage(i ? "Inverted" : "Normal", 200);
+		for (int y = 0; y < 200; ++y)
+			for (int x = 0; x < 200; ++x)
+				img.set(i * 200 + x, y, i ? 255 - symbol.get(x, y) : symbol.get(x, y));
+	}
+
+	for (int threads : {1, 2}) {
+		auto opts = ReaderOptions().formats(BarcodeFormat::QRCode).maxThreads(threads);
+		auto barcodes = ReadBarcodes(ToImageView(img), opts);
+		ASSERT_EQ(barcodes.size(), 2);
+		for (auto& barcode : barcodes)
+			EXPECT_EQ(barcode.isInverted(), barcode.text() == "Inverted");
+
+		auto normal = ReadBarcodes(ToImageView(img), ReaderOptions(opts).tryInvert(false));
+		ASSERT_EQ(normal.size(), 1);
+		EXPECT_EQ(normal[0].text(), "Normal");
+	}
+}
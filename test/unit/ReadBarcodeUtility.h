@@ -0,0 +1,43 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "BitMatrix.h"
+#include "ReadBarcode.h"
+
+#include "gtest/gtest.h"
+
+#include <initializer_list>
+#include <string>
+
+namespace ZXing {
+
+inline ImageView ToImageView(const Matrix<uint8_t>& img)
+{
+	return {img.data(), img.width(), img.height(), ImageFormat::Lum};
+}
+
+// Reads the image serially and with each of the given maxThreads and expects the same results, including the properties
+// operator== does not look at but that depend on how the readers were called. Returns the serial results.
+inline Barcodes ExpectSameWithThreads(const ImageView& iv, const ReaderOptions& opts, std::initializer_list<int> threads = {0, 2, 5})
+{
+	auto expected = ReadBarcodes(iv, ReaderOptions(opts).maxThreads(1));
+	for (int t : threads) {
+		SCOPED_TRACE("maxThreads " + std::to_string(t));
+		auto barcodes = ReaderSession(ReaderOptions(opts).maxThreads(t)).read(iv);
+		EXPECT_EQ(barcodes, expected);
+		if (barcodes.size() != expected.size())
+			continue;
+		for (size_t i = 0; i < barcodes.size(); ++i) {
+			EXPECT_EQ(barcodes[i].position(), expected[i].position()) << i;
+			EXPECT_EQ(barcodes[i].lineCount(), expected[i].lineCount()) << i;
+			EXPECT_EQ(barcodes[i].isInverted(), expected[i].isInverted()) << i;
+		}
+	}
+	return expected;
+}
+
+} // namespace ZXing
@@ -0,0 +1,95 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Deadline.h"
+#include "ThreadPool.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+using namespace ZXing;
+
+TEST(ThreadPoolTest, EachIndexOnce)
+{
+	for (int threads : {1, 2, 4}) {
+		ThreadPool pool(threads);
+		EXPECT_EQ(pool.size(), threads);
+
+		for (int count : {0, 1, 3, 100}) {
+			std::vector<std::atomic<int>> calls(count);
+			std::atomic<bool> workerInRange = true;
+			pool.parallelFor(count, [&](int i, int worker) {
+				calls[i]++;
+				if (worker < 0 || worker >= pool.size())
+					workerInRange = false;
+			});
+			for (auto& c : calls)
+				EXPECT_EQ(c, 1);
+			EXPECT_TRUE(workerInRange);
+		}
+	}
+}
+
+TEST(ThreadPoolTest, Nested)
+{
+	ThreadPool pool(3);
+	std::atomic<int> sum = 0;
+	pool.parallelFor(10, [&](int, int outer) {
+		pool.parallelFor(10, [&](int i, int inner) {
+			EXPECT_EQ(inner, outer);
+			sum += i;
+		});
+	});
+	EXPECT_EQ(sum, 10 * 45);
+}
+
+TEST(ThreadPoolTest, Exception)
+{
+	ThreadPool pool(2);
+	EXPECT_THROW(pool.parallelFor(100, [](int i, int) {
+		if (i == 42)
+			throw std::runtime_error("42");
+	}), std::runtime_error);
+
+	// the pool is still usable afterwards
+	std::atomic<int> n = 0;
+	pool.parallelFor(100, [&](int, int) { n++; });
+	EXPECT_EQ(n, 100);
+}
+
+TEST(ThreadPoolTest, Concurrent)
+{
+	EXPECT_FALSE(ThreadPool(1).concurrent());
+
+	ThreadPool pool(2);
+	EXPECT_TRUE(pool.concurrent());
+	std::atomic<int> nested = 0;
+	pool.parallelFor(10, [&](int, int) { nested += !pool.concurrent(); });
+	EXPECT_EQ(nested, 10);
+}
+
+TEST(ThreadPoolTest, Deadline)
+{
+	ThreadPool pool(3);
+	std::atomic<bool> cancelled = true;
+	std::atomic<int> expired = 0;
+
+	// the background workers check the deadlines of the calling thread
+	{
+		Deadline deadline(std::chrono::microseconds(0), &cancelled);
+		Deadline::Scope scope(deadline);
+		pool.parallelFor(30, [&](int, int) { expired += Deadline::Expired(); });
+	}
+	EXPECT_EQ(expired, 30);
+
+	// and only while the caller has them installed
+	expired = 0;
+	pool.parallelFor(30, [&](int, int) { expired += Deadline::Expired(); });
+	EXPECT_EQ(expired, 0);
+}
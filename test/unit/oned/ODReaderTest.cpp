@@ -0,0 +1,113 @@
+/*
+* Copyright 2026 Axel Waggershauser
+*/
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ReadBarcodeUtility.h"
+#include "oned/ODCode128Writer.h"
+#include "oned/ODEAN13Writer.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+using namespace ZXing;
+
+TEST(ODReaderTest, MaxThreads)
+{
+	// two linear symbols above each other in a tall image, so the rows are scanned in several chunks
+	auto code128 = ToMatrix<uint8_t>(OneD::Code128Writer().encode("Threads", 400, 300));
+	auto ean13 = ToMatrix<uint8_t>(OneD::EAN13Writer().encode("4006381333931", 400, 300));
+	Matrix<uint8_t> img(400, 1200, 255);
+	for (int y = 0; y < 300; ++y)
+		for (int x = 0; x < 400; ++x) {
+			img.set(x, 200 + y, code128.get(x, y));
+			img.set(x, 700 + y, ean13.get(x, y));
+		}
+
+	// the same symbols upside down, so they are found in the reversed rows
+	Matrix<uint8_t> flipped(img.width(), img.height());
+	for (int y = 0; y < img.height(); ++y)
+		for (int x = 0; x < img.width(); ++x)
+			flipped.set(img.width() - 1 - x, img.height() - 1 - y, img.get(x, y));
+
+	for (auto* image : {&img, &flipped})
+		for (int maxSymbols : {0, 1}) {
+			auto opts = ReaderOptions().formats(BarcodeFormat::AllLinear).maxNumberOfSymbols(maxSymbols);
+			EXPECT_EQ(ExpectSameWithThreads(ToImageView(*image), opts).size(), maxSymbols ? 1 : 2);
+		}
+}
+
+TEST(ODReaderTest, ClaimedSpans)
+{
+	// a label with 2x2 linear symbols, the readers skip the pixels of an already confirmed one on the rows close to it
+	Matrix<uint8_t> img(700, 400, 255);
+	const char* texts[] = {"Label 1", "Label 2", "Label 3", "Label 4"};
+	for (int i = 0; i < 4; ++i) {
+		auto symbol = ToMatrix<uint8_t>(OneD::Code128Writer().encode(texts[i], 300, 150));
+		for (int y = 0; y < 150; ++y)
+			for (int x = 0; x < 300; ++x)
+				img.set(30 + x + i % 2 * 340, 30 + y + i / 2 * 200, symbol.get(x, y));
+	}
+
+	auto barcodes = ExpectSameWithThreads(ToImageView(img), ReaderOptions().formats(BarcodeFormat::AllLinear).maxNumberOfSymbols(0));
+	ASSERT_EQ(barcodes.size(), 4);
+	for (auto& barcode : barcodes) {
+		int i = static_cast<int>(std::find(std::begin(texts), std::end(texts), barcode.text()) - std::begin(texts));
+		ASSERT_LT(i, 4) << barcode.text();
+		auto pos = barcode.position();
+		EXPECT_TRUE(pos.topLeft().x > 30 + i % 2 * 340 && pos.topRight().x < 330 + i % 2 * 340) << barcode.text();
+		// the skipped rows still count, as they contain the same bars
+		EXPECT_EQ(pos.topLeft().y, 30 + i / 2 * 200) << barcode.text();
+		EXPECT_EQ(pos.bottomLeft().y, 179 + i / 2 * 200) << barcode.text();
+		EXPECT_EQ(barcode.lineCount(), 150) << barcode.text();
+	}
+}
+
+TEST(ODReaderTest, Oblique)
+{
+	// a wide but short symbol that is not crossed completely by any row or column unless it is (almost) axis aligned
+	auto symbol = ToMatrix<uint8_t>(OneD::Code128Writer().encode("Oblique", 400, 50));
+	const int size = 480;
+	for (int angle : {30, 45, 65, 120, 160}) {
+		double rad = angle * std::numbers::pi / 180, c = std::cos(rad), s = std::sin(rad);
+		Matrix<uint8_t> img(size, size, 255);
+		for (int y = 0; y < size; ++y)
+			for (int x = 0; x < size; ++x) {
+				// rotate clockwise around the center of the image
+				double dx = x - size / 2, dy = y - size / 2;
+				int sx = static_cast<int>(std::lround(c * dx + s * dy + symbol.width() / 2));
+				int sy = static_cast<int>(std::lround(-s * dx + c * dy + symbol.height() / 2));
+				if (sx >= 0 && sx < symbol.width() && sy >= 0 && sy < symbol.height())
+					img.set(x, y, symbol.get(sx, sy));
+			}
+
+		auto opts = ReaderOptions().formats(BarcodeFormat::Code128);
+		EXPECT_TRUE(ReadBarcodes(ToImageView(img), opts).empty()) << angle;
+		auto barcodes = ExpectSameWithThreads(ToImageView(img), opts.tryOblique(true), {0, 2});
+		ASSERT_EQ(barcodes.size(), 1) << angle;
+		EXPECT_EQ(barcodes[0].text(), "Oblique");
+		auto center = Center(barcodes[0].position());
+		EXPECT_LT(std::abs(center.x - size / 2) + std::abs(center.y - size / 2), 20) << angle;
+		// the orientation of a symbol read from the right to the left is off by 180 degrees
+		int dAngle = (barcodes[0].orientation() - angle + 360) % 180;
+		EXPECT_LT(std::min(dAngle, 180 - dAngle), 15) << angle << " " << barcodes[0].orientation();
+	}
+
+	// a vertical symbol is found by the columns, with tryOblique they are sampled like the oblique lines
+	Matrix<uint8_t> vertical(size, size, 255);
+	for (int y = 0; y < symbol.width(); ++y)
+		for (int x = 0; x < symbol.height(); ++x)
+			vertical.set(size / 2 + x, 40 + y, symbol.get(y, symbol.height() - 1 - x));
+	auto opts = ReaderOptions().formats(BarcodeFormat::Code128);
+	auto expected = ReadBarcodes(ToImageView(vertical), opts);
+	ASSERT_EQ(expected.size(), 1);
+	auto barcodes = ExpectSameWithThreads(ToImageView(vertical), opts.tryOblique(true), {0, 2});
+	ASSERT_EQ(barcodes.size(), 1);
+	EXPECT_EQ(barcodes[0].text(), "Oblique");
+	EXPECT_EQ(barcodes[0].orientation(), expected[0].orientation());
+	for (int i = 0; i < 4; ++i)
+		EXPECT_LE(maxAbsComponent(barcodes[0].position()[i] - expected[0].position()[i]), 2) << i;
+}
@@ -245,6 +245,7 @@ static ReaderOptions CreateReaderOptions(JNIEnv* env, jobject opts)
 		.tryDenoise(GetBooleanField(env, cls, opts, "tryDenoise"))
 		.isPure(GetBooleanField(env, cls, opts, "isPure"))
 		.binarizer(static_cast<Binarizer>(GetEnumOrdinal(env, env->GetObjectField(opts, env->GetFieldID(cls, "binarizer", "L" PACKAGE "Binarizer;")))))
+		.binarizerWindow(GetIntField(env, cls, opts, "binarizerWindow"))
 		.downscaleThreshold(GetIntField(env, cls, opts, "downscaleThreshold"))
 		.downscaleFactor(GetIntField(env, cls, opts, "downscaleFactor"))
 		.minLineCount(GetIntField(env, cls, opts, "minLineCount"))
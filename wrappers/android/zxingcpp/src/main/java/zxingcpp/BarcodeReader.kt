@@ -87,7 +87,7 @@ public class BarcodeReader(public var options: Options = Options()) {
 	}
 
 	public enum class Binarizer {
-		LOCAL_AVERAGE, GLOBAL_HISTOGRAM, FIXED_THRESHOLD, BOOL_CAST
+		LOCAL_AVERAGE, GLOBAL_HISTOGRAM, FIXED_THRESHOLD, BOOL_CAST, ADAPTIVE
 	}
 
 	public enum class EanAddOnSymbol {
@@ -111,6 +111,7 @@ public class BarcodeReader(public var options: Options = Options()) {
 		var tryDenoise: Boolean = false,
 		var isPure: Boolean = false,
 		var binarizer: Binarizer = Binarizer.LOCAL_AVERAGE,
+		var binarizerWindow: Int = 0,
 		var downscaleFactor: Int = 3,
 		var downscaleThreshold: Int = 500,
 		var minLineCount: Int = 2,
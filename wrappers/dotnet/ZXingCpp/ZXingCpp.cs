@@ -40,6 +40,8 @@ internal class Dll
 	[DllImport(DllName)] public static extern IntPtr ZXing_ReaderOptions_getFormats(IntPtr opts, out int count);
 	[DllImport(DllName)] public static extern void ZXing_ReaderOptions_setBinarizer(IntPtr opts, Binarizer binarizer);
 	[DllImport(DllName)] public static extern Binarizer ZXing_ReaderOptions_getBinarizer(IntPtr opts);
+	[DllImport(DllName)] public static extern void ZXing_ReaderOptions_setBinarizerWindow(IntPtr opts, int window);
+	[DllImport(DllName)] public static extern int ZXing_ReaderOptions_getBinarizerWindow(IntPtr opts);
 	[DllImport(DllName)] public static extern void ZXing_ReaderOptions_setEanAddOnSymbol(IntPtr opts, EanAddOnSymbol eanAddOnSymbol);
 	[DllImport(DllName)] public static extern EanAddOnSymbol ZXing_ReaderOptions_getEanAddOnSymbol(IntPtr opts);
 	[DllImport(DllName)] public static extern void ZXing_ReaderOptions_setTextMode(IntPtr opts, TextMode textMode);
@@ -282,6 +284,8 @@ public enum Binarizer
 	FixedThreshold,
 	/// <summary>Threshold at 0, fastest option.</summary>
 	BoolCast,
+	/// <summary>Mean and standard deviation of neighboring pixels (Sauvola), for unevenly lit images.</summary>
+	Adaptive,
 };
 
 /// <summary>Handling of EAN-2/EAN-5 Add-On symbols.</summary>
@@ -528,6 +532,13 @@ public class ReaderOptions : IDisposable
 		set => ZXing_ReaderOptions_setBinarizer(_d, value);
 	}
 
+	/// <summary>Window size (in pixels) of the Adaptive binarizer, 0 means 1/4th of the smaller image dimension (default is 0).</summary>
+	public int BinarizerWindow
+	{
+		get => ZXing_ReaderOptions_getBinarizerWindow(_d);
+		set => ZXing_ReaderOptions_setBinarizerWindow(_d, value);
+	}
+
 	public EanAddOnSymbol EanAddOnSymbol
 	{
 		get => ZXing_ReaderOptions_getEanAddOnSymbol(_d);
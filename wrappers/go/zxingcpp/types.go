@@ -35,6 +35,7 @@ const (
 	BinarizerGlobalHistogram Binarizer = C.ZXing_Binarizer_GlobalHistogram
 	BinarizerFixedThreshold  Binarizer = C.ZXing_Binarizer_FixedThreshold
 	BinarizerBoolCast        Binarizer = C.ZXing_Binarizer_BoolCast
+	BinarizerAdaptive        Binarizer = C.ZXing_Binarizer_Adaptive
 )
 
 // EanAddOnSymbol specifies whether to ignore, read or require EAN-2/5 add-on symbols while scanning EAN/UPC codes.
@@ -10,7 +10,8 @@ typedef NS_ENUM(NSInteger, ZXIBinarizer) {
     ZXIBinarizerLocalAverage,
     ZXIBinarizerGlobalHistogram,
     ZXIBinarizerFixedThreshold,
-    ZXIBinarizerBoolCast
+    ZXIBinarizerBoolCast,
+    ZXIBinarizerAdaptive
 };
 
 typedef NS_ENUM(NSInteger, ZXIEanAddOnSymbol) {
@@ -93,6 +93,8 @@
             return ZXIBinarizer::ZXIBinarizerFixedThreshold;
         case ZXing::Binarizer::BoolCast:
             return ZXIBinarizer::ZXIBinarizerBoolCast;
+        case ZXing::Binarizer::Adaptive:
+            return ZXIBinarizer::ZXIBinarizerAdaptive;
     }
 }
 
@@ -107,6 +109,8 @@ ZXing::Binarizer toNativeBinarizer(ZXIBinarizer binarizer) {
             return ZXing::Binarizer::FixedThreshold;
         case ZXIBinarizerBoolCast:
             return ZXing::Binarizer::BoolCast;
+        case ZXIBinarizerAdaptive:
+            return ZXing::Binarizer::Adaptive;
     }
 }
 
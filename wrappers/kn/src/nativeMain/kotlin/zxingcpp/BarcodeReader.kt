@@ -98,7 +98,8 @@ enum class Binarizer(internal val cValue: ZXing_Binarizer) {
 	LocalAverage(ZXing_Binarizer_LocalAverage),
 	GlobalHistogram(ZXing_Binarizer_GlobalHistogram),
 	FixedThreshold(ZXing_Binarizer_FixedThreshold),
-	BoolCast(ZXing_Binarizer_BoolCast);
+	BoolCast(ZXing_Binarizer_BoolCast),
+	Adaptive(ZXing_Binarizer_Adaptive);
 
 	companion object {
 		fun fromCValue(cValue: ZXing_Binarizer): Binarizer {
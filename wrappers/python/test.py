@@ -120,6 +120,13 @@ class TestReadWrite(unittest.TestCase):
 
 		self.assertEqual(res, None)
 
+	def test_read_adaptive_window(self):
+		img = zxingcpp.write_barcode(BF.QRCode, "Adaptive")
+		for window in (0, 100):
+			res = zxingcpp.read_barcode(img, binarizer=zxingcpp.Binarizer.Adaptive, binarizer_window=window)
+			self.assertTrue(res.valid)
+			self.assertEqual(res.text, "Adaptive")
+
 	@unittest.skipIf(not has_numpy, "need numpy for read/write tests")
 	def test_failed_read_numpy(self):
 		import numpy as np # pyright: ignore
@@ -93,7 +93,7 @@ static PyType_Slot ImageView_slots[] = {
 
 auto read_barcodes_impl(nb::object _image, const BarcodeFormats& formats, bool try_rotate, bool try_downscale, bool try_invert,
 						TextMode text_mode, Binarizer binarizer, bool is_pure, EanAddOnSymbol ean_add_on_symbol, bool return_errors,
-						uint8_t max_number_of_symbols = 0xff)
+						uint16_t binarizer_window, uint8_t max_number_of_symbols = 0xff)
 {
 	const auto opts = ReaderOptions()
 		.formats(formats)
@@ -102,6 +102,7 @@ auto read_barcodes_impl(nb::object _image, const BarcodeFormats& formats, bool t
 		.tryInvert(try_invert)
 		.textMode(text_mode)
 		.binarizer(binarizer)
+		.binarizerWindow(binarizer_window)
 		.isPure(is_pure)
 		.maxNumberOfSymbols(max_number_of_symbols)
 		.eanAddOnSymbol(ean_add_on_symbol)
@@ -236,18 +237,19 @@ auto read_barcodes_impl(nb::object _image, const BarcodeFormats& formats, bool t
 
 std::optional<Barcode> read_barcode(nb::object _image, const BarcodeFormats& formats, bool try_rotate, bool try_downscale,
 									bool try_invert, TextMode text_mode, Binarizer binarizer, bool is_pure,
-									EanAddOnSymbol ean_add_on_symbol, bool return_errors)
+									EanAddOnSymbol ean_add_on_symbol, bool return_errors, uint16_t binarizer_window)
 {
 	auto res = read_barcodes_impl(_image, formats, try_rotate, try_downscale, try_invert, text_mode, binarizer, is_pure,
-								  ean_add_on_symbol, return_errors, 1);
+								  ean_add_on_symbol, return_errors, binarizer_window, 1);
 	return res.empty() ? std::nullopt : std::optional(res.front());
 }
 
 Barcodes read_barcodes(nb::object _image, const BarcodeFormats& formats, bool try_rotate, bool try_downscale, bool try_invert,
-					   TextMode text_mode, Binarizer binarizer, bool is_pure, EanAddOnSymbol ean_add_on_symbol, bool return_errors)
+					   TextMode text_mode, Binarizer binarizer, bool is_pure, EanAddOnSymbol ean_add_on_symbol, bool return_errors,
+					   uint16_t binarizer_window)
 {
 	return read_barcodes_impl(_image, formats, try_rotate, try_downscale, try_invert, text_mode, binarizer, is_pure, ean_add_on_symbol,
-							  return_errors);
+							  return_errors, binarizer_window);
 }
 
 // MARK: - Writer
@@ -350,6 +352,7 @@ NB_MODULE(zxingcpp, m)
 	nb::enum_<Binarizer>(m, "Binarizer", "Enumeration of binarizers used before decoding images")
 		.value("BoolCast", Binarizer::BoolCast)
 		.value("FixedThreshold", Binarizer::FixedThreshold)
+		.value("Adaptive", Binarizer::Adaptive)
 		.value("GlobalHistogram", Binarizer::GlobalHistogram)
 		.value("LocalAverage", Binarizer::LocalAverage)
 		.export_values();
@@ -522,6 +525,7 @@ NB_MODULE(zxingcpp, m)
 		nb::arg("is_pure") = false,
 		nb::arg("ean_add_on_symbol") = EanAddOnSymbol::Ignore,
 		nb::arg("return_errors") = false,
+		nb::arg("binarizer_window") = 0,
 		"Read (decode) a barcode from a numpy BGR or grayscale image array or from a PIL image.\n\n"
 		":type image: buffer|numpy.ndarray|PIL.Image.Image\n"
 		":param image: The image object to decode. The image can be either:\n"
@@ -554,7 +558,10 @@ NB_MODULE(zxingcpp, m)
 		"  EAN/UPC codes. Default is ``Ignore``.\n"
 		":type return_errors: bool\n"
 		":param return_errors: Set to True to return the barcodes with errors as well (e.g. checksum errors); see ``Barcode.error``.\n"
-		" Default is False."
+		" Default is False.\n"
+		":type binarizer_window: int\n"
+		":param binarizer_window: side length (in pixels) of the neighborhood :py:attr:`zxing.Binarizer.Adaptive` computes\n"
+		"  the threshold of a pixel from. Default is 0, meaning 1/4th of the smaller image dimension.\n"
 		":rtype: zxingcpp.Barcode\n"
 		":return: a Barcode if found, None otherwise"
 	);
@@ -569,6 +576,7 @@ NB_MODULE(zxingcpp, m)
 		nb::arg("is_pure") = false,
 		nb::arg("ean_add_on_symbol") = EanAddOnSymbol::Ignore,
 		nb::arg("return_errors") = false,
+		nb::arg("binarizer_window") = 0,
 		"Read (decode) multiple barcodes from a numpy BGR or grayscale image array or from a PIL image.\n\n"
 		":type image: buffer|numpy.ndarray|PIL.Image.Image\n"
 		":param image: The image object to decode. The image can be either:\n"
@@ -602,6 +610,9 @@ NB_MODULE(zxingcpp, m)
 		":type return_errors: bool\n"
 		":param return_errors: Set to True to return the barcodes with errors as well (e.g. checksum errors); see ``Barcode.error``.\n"
 		" Default is False.\n"
+		":type binarizer_window: int\n"
+		":param binarizer_window: side length (in pixels) of the neighborhood :py:attr:`zxing.Binarizer.Adaptive` computes\n"
+		"  the threshold of a pixel from. Default is 0, meaning 1/4th of the smaller image dimension.\n"
 		":rtype: list[zxingcpp.Barcode]\n"
 		":return: a list of Barcodes, the list is empty if none is found"
 	);
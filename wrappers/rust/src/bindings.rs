@@ -129,6 +129,7 @@ pub const ZXing_Binarizer_LocalAverage: ZXing_Binarizer = 0;
 pub const ZXing_Binarizer_GlobalHistogram: ZXing_Binarizer = 1;
 pub const ZXing_Binarizer_FixedThreshold: ZXing_Binarizer = 2;
 pub const ZXing_Binarizer_BoolCast: ZXing_Binarizer = 3;
+pub const ZXing_Binarizer_Adaptive: ZXing_Binarizer = 4;
 pub type ZXing_Binarizer = ::core::ffi::c_uint;
 pub const ZXing_EanAddOnSymbol_Ignore: ZXing_EanAddOnSymbol = 0;
 pub const ZXing_EanAddOnSymbol_Read: ZXing_EanAddOnSymbol = 1;
@@ -216,7 +216,7 @@ make_zxing_enum!(ImageFormat { Lum, LumA, RGB, BGR, RGBA, ARGB, BGRA, ABGR });
 #[rustfmt::skip]
 make_zxing_enum!(ContentType { Text, Binary, Mixed, GS1, ISO15434, UnknownECI });
 #[rustfmt::skip]
-make_zxing_enum!(Binarizer { LocalAverage, GlobalHistogram, FixedThreshold, BoolCast });
+make_zxing_enum!(Binarizer { LocalAverage, GlobalHistogram, FixedThreshold, BoolCast, Adaptive });
 #[rustfmt::skip]
 make_zxing_enum!(TextMode { Plain, ECI, HRI, Escaped, Hex, HexECI });
 #[rustfmt::skip]